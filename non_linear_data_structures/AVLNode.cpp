@@ -20,8 +20,13 @@
  ******************************************************************************/
 
 
+#ifndef DATA__STRUCTURES_AVLNODE_CPP
+#define DATA__STRUCTURES_AVLNODE_CPP
+
 #include "AVLNode.h"
 
 
 template<typename AVLTREE>
-AVLNode<AVLTREE>::AVLNode(T v) : value{v}, height{}, leftChild{nullptr}, rightChild{nullptr} {}
\ No newline at end of file
+AVLNode<AVLTREE>::AVLNode(T v) : value{v}, height{}, size{1}, leftChild{nullptr}, rightChild{nullptr} {}
+
+#endif //DATA__STRUCTURES_AVLNODE_CPP
@@ -36,6 +36,7 @@ public:
 
     T value;
     std::size_t height;
+    std::size_t size;
     AVLNode *leftChild;
     AVLNode *rightChild;
 };
@@ -29,7 +29,24 @@ AVLTree<T>::AVLTree() : mSize{}, root{nullptr} {
 
 template<typename T>
 AVLTree<T>::~AVLTree() {
-    delete root;
+    clear();
+}
+
+template<typename T>
+void AVLTree<T>::clear() {
+    std::vector<AVLNode *> pending;
+    if (root != nullptr) pending.push_back(root);
+
+    while (!pending.empty()) {
+        auto node = pending.back();
+        pending.pop_back();
+        if (node->leftChild != nullptr) pending.push_back(node->leftChild);
+        if (node->rightChild != nullptr) pending.push_back(node->rightChild);
+        delete node;
+    }
+
+    root = nullptr;
+    mSize = 0;
 }
 
 
@@ -86,9 +103,9 @@ auto AVLTree<T>::insert(AVLNode *pRoot, const T &item) {
         pRoot->rightChild = insert(pRoot->rightChild, item);
 
     /*
-     * Set the height of every node
+     * Set the height (and the subtree size) of every node
      */
-    pRoot->height = std::max(getHeight(pRoot->leftChild), getHeight(pRoot->rightChild)) + 1;
+    update(pRoot);
 
     return balance(pRoot);
 }
@@ -110,40 +127,41 @@ auto *AVLTree<T>::balance(AVLNode *pRoot) {
     return pRoot;
 }
 
+/*
+ * Rotations relink the nodes in place: the child takes the place of pRoot,
+ * which becomes its child, and both heights and sizes are recomputed bottom up.
+ */
+
 template<typename T>
 auto *AVLTree<T>::rotateLeft(AVLNode *pRoot) const {
-    auto newRoot = *pRoot->rightChild;
+    auto newRoot = pRoot->rightChild;
 
-    pRoot->rightChild = nullptr;
-    if (newRoot.leftChild != nullptr)
-        pRoot->rightChild = newRoot.leftChild;
-    newRoot.leftChild = pRoot;
+    pRoot->rightChild = newRoot->leftChild;
+    newRoot->leftChild = pRoot;
 
-    resetHeight(pRoot, newRoot);
+    resetHeight(pRoot, *newRoot);
 
-    return new AVLNode { newRoot };
+    return newRoot;
 }
 
 
 template<typename T>
 auto *AVLTree<T>::rotateRight(AVLNode *pRoot) const {
-    auto newRoot = *pRoot->leftChild;
+    auto newRoot = pRoot->leftChild;
 
-    pRoot->leftChild = nullptr;
-    if (newRoot.rightChild != nullptr)
-        pRoot->leftChild = newRoot.rightChild;
-    newRoot.rightChild = pRoot;
+    pRoot->leftChild = newRoot->rightChild;
+    newRoot->rightChild = pRoot;
 
-    resetHeight(pRoot, newRoot);
+    resetHeight(pRoot, *newRoot);
 
-    return new AVLNode { newRoot };
+    return newRoot;
 }
 
 
 template<typename T>
 void AVLTree<T>::resetHeight(AVLNode *pRoot, AVLNode &newRoot) const {
-    pRoot->height = std::max(getHeight(pRoot->leftChild), getHeight(pRoot->rightChild)) + 1;
-    newRoot.height = std::max(getHeight(newRoot.leftChild), getHeight(newRoot.rightChild)) + 1;
+    update(pRoot);
+    update(&newRoot);
 }
 
 template<typename T>
@@ -167,6 +185,17 @@ int AVLTree<T>::getHeight(const AVLNode *node) const {
     return node == nullptr ? -1 : node->height;
 }
 
+template<typename T>
+std::size_t AVLTree<T>::getSize(const AVLNode *node) const {
+    return node == nullptr ? 0 : node->size;
+}
+
+template<typename T>
+void AVLTree<T>::update(AVLNode *pRoot) const {
+    pRoot->height = std::max(getHeight(pRoot->leftChild), getHeight(pRoot->rightChild)) + 1;
+    pRoot->size = getSize(pRoot->leftChild) + getSize(pRoot->rightChild) + 1;
+}
+
 template<typename T>
 bool AVLTree<T>::isBalanced() {
     return getHeight(root->leftChild) - getHeight(root->rightChild) <= 1;
@@ -187,3 +216,320 @@ template<typename T>
 bool AVLTree<T>::isEmpty() const {
     return mSize == 0;
 }
+
+
+template<typename T>
+bool AVLTree<T>::contains(const T &item) const {
+    auto current = root;
+    while (current != nullptr) {
+        if (item < current->value) current = current->leftChild;
+        else if (current->value < item) current = current->rightChild;
+        else return true;
+    }
+    return false;
+}
+
+template<typename T>
+bool AVLTree<T>::erase(const T &item) {
+    bool erased = false;
+    root = erase(root, item, erased);
+    if (erased) mSize--;
+    return erased;
+}
+
+/*
+ * Same shape as insert: go down, remove, and rebalance every node on the way
+ * back up. A node with two children is replaced by its successor, unlinked
+ * from the right subtree by eraseMin.
+ */
+template<typename T>
+typename AVLTree<T>::AVLNode *AVLTree<T>::erase(AVLNode *pRoot, const T &item, bool &erased) {
+    if (pRoot == nullptr)
+        return nullptr;
+
+    if (item < pRoot->value)
+        pRoot->leftChild = erase(pRoot->leftChild, item, erased);
+    else if (pRoot->value < item)
+        pRoot->rightChild = erase(pRoot->rightChild, item, erased);
+    else {
+        erased = true;
+        auto node = pRoot;
+
+        if (node->leftChild == nullptr || node->rightChild == nullptr) {
+            pRoot = node->leftChild != nullptr ? node->leftChild : node->rightChild;
+            delete node;
+            return pRoot;
+        }
+
+        AVLNode *successor = nullptr;
+        auto right = eraseMin(node->rightChild, successor);
+        successor->leftChild = node->leftChild;
+        successor->rightChild = right;
+        delete node;
+        pRoot = successor;
+    }
+
+    update(pRoot);
+
+    return balance(pRoot);
+}
+
+template<typename T>
+typename AVLTree<T>::AVLNode *AVLTree<T>::eraseMin(AVLNode *pRoot, AVLNode *&min) {
+    if (pRoot->leftChild == nullptr) {
+        min = pRoot;
+        return pRoot->rightChild;
+    }
+
+    pRoot->leftChild = eraseMin(pRoot->leftChild, min);
+    update(pRoot);
+
+    return balance(pRoot);
+}
+
+/*
+ * The last node of the path where the search turned left is the answer, so
+ * the path is cut right after it.
+ */
+template<typename T>
+typename AVLTree<T>::iterator AVLTree<T>::bound(const T &item, bool strict) const {
+    iterator itr{this};
+    std::size_t depth = 0;
+
+    for (auto current = root; current != nullptr;) {
+        itr.path.push_back(current);
+        if (strict ? item < current->value : !(current->value < item)) {
+            depth = itr.path.size();
+            current = current->leftChild;
+        } else {
+            current = current->rightChild;
+        }
+    }
+
+    itr.path.resize(depth);
+    return itr;
+}
+
+template<typename T>
+typename AVLTree<T>::iterator AVLTree<T>::lower_bound(const T &item) const {
+    return bound(item, false);
+}
+
+template<typename T>
+typename AVLTree<T>::iterator AVLTree<T>::upper_bound(const T &item) const {
+    return bound(item, true);
+}
+
+template<typename T>
+typename AVLTree<T>::iterator AVLTree<T>::find(const T &item) const {
+    auto itr = lower_bound(item);
+    return itr == end() || item < *itr ? end() : itr;
+}
+
+template<typename T>
+typename AVLTree<T>::iterator AVLTree<T>::begin() const {
+    iterator itr{this};
+    if (root != nullptr) itr.descendLeft(root);
+    return itr;
+}
+
+template<typename T>
+typename AVLTree<T>::iterator AVLTree<T>::end() const {
+    return iterator{this};
+}
+
+template<typename T>
+template<typename Visitor>
+void AVLTree<T>::range(const T &low, const T &high, Visitor visitor) const {
+    for (auto itr = lower_bound(low); itr != end() && *itr < high; ++itr)
+        visitor(*itr);
+}
+
+/*
+ * Pushes node and then its leftmost (rightmost) descendants
+ */
+template<typename T>
+void AVLTree<T>::iterator::descendLeft(const AVLNode *node) {
+    for (; node != nullptr; node = node->leftChild)
+        path.push_back(node);
+}
+
+template<typename T>
+void AVLTree<T>::iterator::descendRight(const AVLNode *node) {
+    for (; node != nullptr; node = node->rightChild)
+        path.push_back(node);
+}
+
+/*
+ * Next: the leftmost node of the right subtree, or else the first ancestor
+ * reached from its left subtree. Past the last value the path is empty (end).
+ */
+template<typename T>
+typename AVLTree<T>::iterator &AVLTree<T>::iterator::operator++() {
+    auto node = path.back();
+    if (node->rightChild != nullptr) {
+        descendLeft(node->rightChild);
+        return *this;
+    }
+
+    path.pop_back();
+    while (!path.empty() && path.back()->rightChild == node) {
+        node = path.back();
+        path.pop_back();
+    }
+    return *this;
+}
+
+/*
+ * Mirror of ++, and --end() is the last value.
+ */
+template<typename T>
+typename AVLTree<T>::iterator &AVLTree<T>::iterator::operator--() {
+    if (path.empty()) {
+        descendRight(tree->root);
+        return *this;
+    }
+
+    auto node = path.back();
+    if (node->leftChild != nullptr) {
+        descendRight(node->leftChild);
+        return *this;
+    }
+
+    path.pop_back();
+    while (!path.empty() && path.back()->leftChild == node) {
+        node = path.back();
+        path.pop_back();
+    }
+    return *this;
+}
+
+/*
+ * Order statistics: every node knows the size of its subtree, so going down
+ * one path is enough to count the values on its left.
+ */
+template<typename T>
+std::size_t AVLTree<T>::rank(const T &item) const {
+    std::size_t smaller = 0;
+
+    for (auto current = root; current != nullptr;) {
+        if (current->value < item) {
+            smaller += getSize(current->leftChild) + 1;
+            current = current->rightChild;
+        } else {
+            current = current->leftChild;
+        }
+    }
+
+    return smaller;
+}
+
+template<typename T>
+const T &AVLTree<T>::select(std::size_t k) const {
+    if (k >= getSize(root)) throw std::runtime_error{"Index out of range"};
+
+    auto current = root;
+    while (true) {
+        auto left = getSize(current->leftChild);
+        if (k < left) {
+            current = current->leftChild;
+        } else if (k == left) {
+            return current->value;
+        } else {
+            k -= left + 1;
+            current = current->rightChild;
+        }
+    }
+}
+
+template<typename T>
+std::size_t AVLTree<T>::count(const T &low, const T &high) const {
+    if (!(low < high)) return 0;
+    return rank(high) - rank(low);
+}
+
+/*
+ * Bulk construction: the middle value is the root and both halves are built
+ * the same way, so the two subtrees of every node differ by at most one node
+ * and no rotation is ever needed. The left half goes to a new thread while
+ * there are threads left and the range is big enough.
+ */
+template<typename T>
+template<typename Iterator>
+void AVLTree<T>::fromSorted(Iterator begin, Iterator end, unsigned threads) {
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+    if constexpr (!std::is_base_of_v<std::random_access_iterator_tag, Category>) {
+        std::vector<T> values(begin, end);
+        fromSorted(values.begin(), values.end(), threads);
+    } else {
+        if (!std::is_sorted(begin, end)) throw std::runtime_error{"Values are not sorted"};
+
+        clear();
+        auto make = [begin](std::size_t index) { return new AVLNode{begin[index]}; };
+        mSize = static_cast<std::size_t>(end - begin);
+        root = build(0, mSize, make, std::max(threads, 1u));
+    }
+}
+
+/*
+ * Both trees are flattened in order, merged like two sorted arrays and the
+ * same nodes are linked again into one balanced tree: nothing is allocated or
+ * compared more than once.
+ */
+template<typename T>
+void AVLTree<T>::merge(AVLTree &other, unsigned threads) {
+    if (&other == this || other.root == nullptr) return;
+
+    std::vector<AVLNode *> mine, theirs, nodes(mSize + other.mSize);
+    mine.reserve(mSize);
+    theirs.reserve(other.mSize);
+    flatten(root, mine);
+    flatten(other.root, theirs);
+    std::merge(mine.begin(), mine.end(), theirs.begin(), theirs.end(), nodes.begin(),
+               [](const AVLNode *a, const AVLNode *b) { return a->value < b->value; });
+
+    auto make = [&nodes](std::size_t index) { return nodes[index]; };
+    mSize = nodes.size();
+    root = build(0, mSize, make, std::max(threads, 1u));
+
+    other.root = nullptr;
+    other.mSize = 0;
+}
+
+template<typename T>
+template<typename Make>
+typename AVLTree<T>::AVLNode *AVLTree<T>::build(std::size_t first, std::size_t count, Make &make, unsigned threads) {
+    if (count == 0)
+        return nullptr;
+
+    auto leftCount = count / 2;
+    auto node = make(first + leftCount);
+
+    if (threads > 1 && count >= minimumChunk) {
+        std::thread worker{[&, threads]() { node->leftChild = build(first, leftCount, make, threads / 2); }};
+        node->rightChild = build(first + leftCount + 1, count - leftCount - 1, make, threads - threads / 2);
+        worker.join();
+    } else {
+        node->leftChild = build(first, leftCount, make, 1);
+        node->rightChild = build(first + leftCount + 1, count - leftCount - 1, make, 1);
+    }
+
+    update(node);
+    return node;
+}
+
+template<typename T>
+void AVLTree<T>::flatten(AVLNode *pRoot, std::vector<AVLNode *> &nodes) {
+    std::vector<AVLNode *> pending;
+
+    for (auto current = pRoot; current != nullptr || !pending.empty();) {
+        for (; current != nullptr; current = current->leftChild)
+            pending.push_back(current);
+
+        current = pending.back();
+        pending.pop_back();
+        nodes.push_back(current);
+        current = current->rightChild;
+    }
+}
@@ -11,6 +11,12 @@
  * Features, being N the number of elements in the tree:
  * 1. Guaranteed search time is O(log(N)).
  * 2. Dynamically updated/balanced tree structure O(N) storage.
+ * 3. Insert, erase, find, lower_bound, upper_bound O(log(N)).
+ * 4. In-order iteration (both directions) O(1) amortized per step, range
+ *    scan of K values O(log(N) + K).
+ * 5. Order statistics O(log(N)): every node also keeps the size of its subtree.
+ * 6. Bulk load from sorted values and merge of two trees O(N), the result is
+ *    perfectly balanced.
  *
  * http://en.wikipedia.org/wiki/AVL_tree
  *
@@ -23,7 +29,16 @@
 #ifndef DATA__STRUCTURES_AVLTREE_H
 #define DATA__STRUCTURES_AVLTREE_H
 
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
 #include "AVLNode.h"
+#include "AVLNode.cpp"
 
 template<typename T>
 class AVLTree {
@@ -32,12 +47,64 @@ public:
     using AVLNode = AVLNode<AVLTree<T>>;
     using ValueType = T;
 
+    /*
+     * In-order bidirectional iterator. Nodes have no parent pointer, so the
+     * iterator keeps the path from the root down to its node and walks it back
+     * up when leaving a subtree. Values are read only, changing one would
+     * break the order.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+    public:
+        iterator() : tree{nullptr} {}
+
+        reference operator*() const { return path.back()->value; }
+
+        pointer operator->() const { return &path.back()->value; }
+
+        iterator &operator++();
+
+        iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+
+        iterator &operator--();
+
+        iterator operator--(int) { auto copy = *this; --*this; return copy; }
+
+        bool operator==(const iterator &rhs) const {
+            return path.empty() ? rhs.path.empty() : !rhs.path.empty() && path.back() == rhs.path.back();
+        }
+
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+    private:
+        friend class AVLTree;
+
+        explicit iterator(const AVLTree *tree) : tree{tree} {}
+
+        void descendLeft(const AVLNode *node);
+
+        void descendRight(const AVLNode *node);
+
+        const AVLTree *tree;
+        std::vector<const AVLNode *> path;
+    };
+
 public:
 
     AVLTree();
 
     ~AVLTree();
 
+    AVLTree(const AVLTree &other) = delete;
+
+    AVLTree &operator=(const AVLTree &other) = delete;
+
 public:
 
     void insert_(const T &item);
@@ -48,7 +115,63 @@ public:
 
     bool isPerfect();
 
+    bool contains(const T &item) const;
+
+    /*
+     * Removes one occurrence of item, returns false if there is none
+     */
+    bool erase(const T &item);
+
+    /*
+     * find: an element equal to item, or end()
+     * lower_bound: the first element not less than item
+     * upper_bound: the first element greater than item
+     */
+    iterator find(const T &item) const;
+
+    iterator lower_bound(const T &item) const;
+
+    iterator upper_bound(const T &item) const;
+
+    iterator begin() const;
+
+    iterator end() const;
+
+    /*
+     * Calls visitor(value) for every value in [low, high), in order
+     */
+    template<typename Visitor>
+    void range(const T &low, const T &high, Visitor visitor) const;
+
+    /*
+     * rank: number of values less than item
+     * select: the k-th smallest value (k from 0), e.g. select(size() * 99 / 100) for p99
+     * count: number of values in [low, high)
+     */
+    std::size_t rank(const T &item) const;
+
+    const T &select(std::size_t k) const;
+
+    std::size_t count(const T &low, const T &high) const;
+
+    /*
+     * fromSorted: replaces the content with the values of [begin, end), which
+     * must be sorted, without a single rotation; the subtrees are built by up
+     * to `threads` threads
+     * merge: moves the nodes of other into this tree, other ends up empty
+     */
+    template<typename Iterator>
+    void fromSorted(Iterator begin, Iterator end, unsigned threads = 1);
+
+    void merge(AVLTree &other, unsigned threads = 1);
+
+    constexpr std::size_t size() const;
+
+    bool isEmpty() const;
+
 private:
+    static constexpr std::size_t minimumChunk = 1 << 14;
+
     std::size_t mSize;
     AVLNode *root;
 
@@ -58,14 +181,38 @@ private:
 
     auto insert(AVLNode *pRoot, const T &item);
 
+    void clear();
+
+    /*
+     * Balanced subtree over the nodes make(first) .. make(first + count - 1),
+     * taken in order
+     */
+    template<typename Make>
+    AVLNode *build(std::size_t first, std::size_t count, Make &make, unsigned threads);
+
+    static void flatten(AVLNode *pRoot, std::vector<AVLNode *> &nodes);
+
     bool isLeaf(const AVLNode *pRoot) const;
 
-    constexpr std::size_t size() const;
+    AVLNode *erase(AVLNode *pRoot, const T &item, bool &erased);
 
-    bool isEmpty() const;
+    AVLNode *eraseMin(AVLNode *pRoot, AVLNode *&min);
+
+    /*
+     * Path from the root to the first node whose value is not less than item
+     * (strict: greater than item)
+     */
+    iterator bound(const T &item, bool strict) const;
 
     int getHeight(const AVLNode *pRoot) const;
 
+    std::size_t getSize(const AVLNode *pRoot) const;
+
+    /*
+     * Height and subtree size from the children's
+     */
+    void update(AVLNode *pRoot) const;
+
     int getBalanceFactor(const AVLNode *pRoot) const;
 
     bool isLeftHeavy(int balanceFactor) const;
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Adjacency Table (mutable directed adjacency with hashed edges)
+ *
+ * https://en.wikipedia.org/wiki/Open_addressing
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_ADJACENCYTABLE_CPP
+#define DATA__STRUCTURES_ADJACENCYTABLE_CPP
+
+#include "AdjacencyTable.h"
+
+
+template<typename ID>
+AdjacencyTable<ID>::AdjacencyTable() : slots(16, Slot{empty, 0, 0}), count{}, shift{60} {}
+
+
+template<typename ID>
+void AdjacencyTable<ID>::addVertex(ID id) {
+    if (id >= vertices.size())
+        vertices.resize(static_cast<std::size_t>(id) + 1);
+}
+
+
+template<typename ID>
+void AdjacencyTable<ID>::removeVertex(ID id) {
+    if (id >= vertices.size())
+        throw std::runtime_error{"No such vertex"};
+
+    auto &edges = vertices[id];
+    while (!edges.out.empty())
+        removeEdge(id, edges.out.back());
+    while (!edges.in.empty())
+        removeEdge(edges.in.back(), id);
+}
+
+
+template<typename ID>
+bool AdjacencyTable<ID>::addEdge(ID from, ID to) {
+    if (from >= vertices.size() || to >= vertices.size())
+        throw std::runtime_error{"No such vertex"};
+
+    auto key = keyOf(from, to);
+    if (find(key) != slots.size())
+        return false;
+
+    if (2 * (count + 1) > slots.size())
+        grow();
+
+    auto slot = home(key);
+    while (slots[slot].key != empty)
+        slot = (slot + 1) & (slots.size() - 1);
+
+    auto &out = vertices[from].out;
+    auto &in = vertices[to].in;
+    slots[slot] = Slot{key, static_cast<std::uint32_t>(out.size()), static_cast<std::uint32_t>(in.size())};
+    out.push_back(to);
+    in.push_back(from);
+    count++;
+    return true;
+}
+
+/*
+ * The last successor of `from` takes the place of `to`, the last predecessor
+ * of `to` takes the place of `from`, and both moved edges get their new
+ * positions in the table.
+ */
+
+template<typename ID>
+bool AdjacencyTable<ID>::removeEdge(ID from, ID to) {
+    if (from >= vertices.size() || to >= vertices.size())
+        return false;
+
+    auto slot = find(keyOf(from, to));
+    if (slot == slots.size())
+        return false;
+
+    auto outPosition = slots[slot].outPosition;
+    auto inPosition = slots[slot].inPosition;
+    erase(slot);
+
+    auto &out = vertices[from].out;
+    if (outPosition + 1 != out.size()) {
+        out[outPosition] = out.back();
+        slots[find(keyOf(from, out[outPosition]))].outPosition = outPosition;
+    }
+    out.pop_back();
+
+    auto &in = vertices[to].in;
+    if (inPosition + 1 != in.size()) {
+        in[inPosition] = in.back();
+        slots[find(keyOf(in[inPosition], to))].inPosition = inPosition;
+    }
+    in.pop_back();
+
+    count--;
+    return true;
+}
+
+
+template<typename ID>
+bool AdjacencyTable<ID>::hasEdge(ID from, ID to) const {
+    return find(keyOf(from, to)) != slots.size();
+}
+
+
+template<typename ID>
+const std::vector<ID> &AdjacencyTable<ID>::successors(ID id) const {
+    return vertices.at(id).out;
+}
+
+
+template<typename ID>
+const std::vector<ID> &AdjacencyTable<ID>::predecessors(ID id) const {
+    return vertices.at(id).in;
+}
+
+
+template<typename ID>
+std::size_t AdjacencyTable<ID>::edgeCount() const {
+    return count;
+}
+
+
+template<typename ID>
+std::uint64_t AdjacencyTable<ID>::keyOf(ID from, ID to) {
+    return static_cast<std::uint64_t>(from) << 32 | static_cast<std::uint32_t>(to);
+}
+
+/*
+ * Fibonacci hashing: the top bits of key * 2^64 / phi
+ */
+
+template<typename ID>
+std::size_t AdjacencyTable<ID>::home(std::uint64_t key) const {
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+
+template<typename ID>
+std::size_t AdjacencyTable<ID>::find(std::uint64_t key) const {
+    for (auto slot = home(key);; slot = (slot + 1) & (slots.size() - 1)) {
+        if (slots[slot].key == key)
+            return slot;
+        if (slots[slot].key == empty)
+            return slots.size();
+    }
+}
+
+/*
+ * Backward shift: the following entries of the cluster are moved back into the
+ * hole when that brings them closer to (or onto) their home slot.
+ */
+
+template<typename ID>
+void AdjacencyTable<ID>::erase(std::size_t slot) {
+    auto mask = slots.size() - 1;
+    auto hole = slot;
+
+    for (auto next = (hole + 1) & mask; slots[next].key != empty; next = (next + 1) & mask) {
+        auto distance = (next - home(slots[next].key)) & mask;
+        if (((next - hole) & mask) <= distance) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+
+    slots[hole].key = empty;
+}
+
+
+template<typename ID>
+void AdjacencyTable<ID>::grow() {
+    std::vector<Slot> old(slots.size() * 2, Slot{empty, 0, 0});
+    old.swap(slots);
+    shift--;
+
+    auto mask = slots.size() - 1;
+    for (auto &entry : old) {
+        if (entry.key == empty)
+            continue;
+        auto slot = home(entry.key);
+        while (slots[slot].key != empty)
+            slot = (slot + 1) & mask;
+        slots[slot] = entry;
+    }
+}
+
+#endif //DATA__STRUCTURES_ADJACENCYTABLE_CPP
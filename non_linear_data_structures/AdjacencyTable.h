@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Adjacency Table (mutable directed adjacency with hashed edges)
+ *
+ * Vertices are dense ids. Every vertex owns two contiguous vectors, its
+ * successors and its predecessors, and an open addressing hash table maps each
+ * edge (from, to) to its position in both vectors. Removing an edge moves the
+ * last entry of each vector into the freed position (swap-remove) and updates
+ * the moved edge in the table, so nothing is ever shifted.
+ *
+ * -> Features, being K the number of edges of a vertex:
+ * 1. Add edge O(1) average
+ * 2. Remove edge O(1) average
+ * 3. Query edge O(1) average
+ * 4. Find successors / predecessors O(K), contiguous
+ * 5. Remove vertex O(K)
+ *
+ * The table uses linear probing with backward shift deletion (no tombstones)
+ * and stays at most half full. Successor order is not kept across removals.
+ *
+ * https://en.wikipedia.org/wiki/Open_addressing
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_ADJACENCYTABLE_H
+#define DATA__STRUCTURES_ADJACENCYTABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+template<typename ID = std::uint32_t>
+class AdjacencyTable {
+
+    static_assert(sizeof(ID) <= 4, "Edge keys pack two ids in 64 bits");
+
+public:
+
+    AdjacencyTable();
+
+public:
+
+    /*
+     * Makes room for vertex ids up to id (a new vertex has no edges)
+     */
+    void addVertex(ID id);
+
+    /*
+     * Removes every edge entering or leaving the vertex, the id may be reused
+     */
+    void removeVertex(ID id);
+
+    /*
+     * Returns false when the edge already exists
+     */
+    bool addEdge(ID from, ID to);
+
+    /*
+     * Returns false when there is no such edge
+     */
+    bool removeEdge(ID from, ID to);
+
+    [[nodiscard]] bool hasEdge(ID from, ID to) const;
+
+    [[nodiscard]] const std::vector<ID> &successors(ID id) const;
+
+    [[nodiscard]] const std::vector<ID> &predecessors(ID id) const;
+
+    [[nodiscard]] std::size_t edgeCount() const;
+
+private:
+
+    struct Slot {
+        std::uint64_t key;
+        std::uint32_t outPosition;
+        std::uint32_t inPosition;
+    };
+
+    struct Edges {
+        std::vector<ID> out;
+        std::vector<ID> in;
+    };
+
+    static constexpr std::uint64_t empty = std::numeric_limits<std::uint64_t>::max();
+
+private:
+
+    std::vector<Edges> vertices;
+    std::vector<Slot> slots;
+    std::size_t count;
+    unsigned shift;
+
+private:
+
+    static std::uint64_t keyOf(ID from, ID to);
+
+    [[nodiscard]] std::size_t home(std::uint64_t key) const;
+
+    [[nodiscard]] std::size_t find(std::uint64_t key) const;
+
+    void erase(std::size_t slot);
+
+    void grow();
+};
+
+
+#endif //DATA__STRUCTURES_ADJACENCYTABLE_H
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Arena (bump / region allocator)
+ *
+ * https://en.wikipedia.org/wiki/Region-based_memory_management
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_ARENA_CPP
+#define DATA__STRUCTURES_ARENA_CPP
+
+#include "Arena.h"
+
+
+template<std::size_t BLOCK_SIZE>
+Arena<BLOCK_SIZE>::Arena() : current{nullptr}, remaining{} {}
+
+
+template<std::size_t BLOCK_SIZE>
+Arena<BLOCK_SIZE>::~Arena() {
+    release();
+}
+
+/*
+ * The current pointer is rounded up to the alignment; when the block is full a
+ * new one is started. Requests bigger than a block get a block of their own
+ * (the current block stays in use for the next small requests).
+ */
+
+template<std::size_t BLOCK_SIZE>
+void *Arena<BLOCK_SIZE>::allocate(std::size_t size, std::size_t alignment) {
+    auto address = reinterpret_cast<std::uintptr_t>(current);
+    auto padding = (alignment - address % alignment) % alignment;
+
+    if (current == nullptr || padding + size > remaining) {
+        if (size + alignment > BLOCK_SIZE) {
+            auto block = static_cast<std::byte *>(::operator new(size + alignment));
+            blocks.push_back(block);
+            return block + (alignment - reinterpret_cast<std::uintptr_t>(block) % alignment) % alignment;
+        }
+
+        current = static_cast<std::byte *>(::operator new(BLOCK_SIZE));
+        blocks.push_back(current);
+        remaining = BLOCK_SIZE;
+
+        address = reinterpret_cast<std::uintptr_t>(current);
+        padding = (alignment - address % alignment) % alignment;
+    }
+
+    auto memory = current + padding;
+    current += padding + size;
+    remaining -= padding + size;
+    return memory;
+}
+
+
+template<std::size_t BLOCK_SIZE>
+template<typename U, typename... Args>
+U *Arena<BLOCK_SIZE>::create(Args &&... args) {
+    return new(allocate(sizeof(U), alignof(U))) U(std::forward<Args>(args)...);
+}
+
+
+template<std::size_t BLOCK_SIZE>
+void Arena<BLOCK_SIZE>::release() {
+    for (auto block : blocks)
+        ::operator delete(block);
+
+    blocks.clear();
+    current = nullptr;
+    remaining = 0;
+}
+
+
+template<std::size_t BLOCK_SIZE>
+std::size_t Arena<BLOCK_SIZE>::blockCount() const {
+    return blocks.size();
+}
+
+#endif //DATA__STRUCTURES_ARENA_CPP
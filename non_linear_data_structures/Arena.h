@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Arena (bump / region allocator)
+ *
+ * Memory is taken from large blocks by moving a pointer forward; nothing is
+ * freed individually, every block is released at once when the arena dies.
+ *
+ * -> Arena Applications:
+ *  1. Building many small objects that share a lifetime (graph nodes and edges)
+ *  2. Parsers, compilers (ASTs)
+ *
+ * -> Features, being N the number of allocations:
+ * 1. Allocate O(1)
+ * 2. Free everything O(number of blocks) instead of N deletes
+ * 3. Objects allocated one after the other are next to each other in memory
+ *
+ * https://en.wikipedia.org/wiki/Region-based_memory_management
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_ARENA_H
+#define DATA__STRUCTURES_ARENA_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <new>
+
+template<std::size_t BLOCK_SIZE = 64 * 1024>
+class Arena {
+
+public:
+
+    Arena();
+
+    ~Arena();
+
+    Arena(const Arena &other) = delete;
+
+    Arena &operator=(const Arena &other) = delete;
+
+public:
+
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    /*
+     * Constructs a U inside the arena. Its destructor is never run, so U must
+     * not own resources outside the arena.
+     */
+    template<typename U, typename... Args>
+    U *create(Args &&... args);
+
+    void release();
+
+    [[nodiscard]] std::size_t blockCount() const;
+
+private:
+
+    std::vector<std::byte *> blocks;
+    std::byte *current;
+    std::size_t remaining;
+};
+
+/*
+ * Standard allocator handing out arena memory, so std containers (vector, map)
+ * can live in an arena. deallocate() does nothing: the memory comes back when
+ * the arena is destroyed.
+ */
+template<typename U, typename ARENA>
+class ArenaAllocator {
+
+public:
+
+    using value_type = U;
+
+public:
+
+    explicit ArenaAllocator(ARENA *arena) : arena{arena} {}
+
+    template<typename V>
+    ArenaAllocator(const ArenaAllocator<V, ARENA> &other) : arena{other.arena} {}
+
+public:
+
+    U *allocate(std::size_t n) { return static_cast<U *>(arena->allocate(n * sizeof(U), alignof(U))); }
+
+    void deallocate(U *, std::size_t) {}
+
+    template<typename V>
+    bool operator==(const ArenaAllocator<V, ARENA> &rhs) const { return arena == rhs.arena; }
+
+    template<typename V>
+    bool operator!=(const ArenaAllocator<V, ARENA> &rhs) const { return arena != rhs.arena; }
+
+    ARENA *arena;
+};
+
+
+#endif //DATA__STRUCTURES_ARENA_H
@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * B+ Tree (cache line sized nodes)
+ *
+ * https://en.wikipedia.org/wiki/B%2B_tree
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_BPLUSTREE_CPP
+#define DATA__STRUCTURES_BPLUSTREE_CPP
+
+#include "BPlusTree.h"
+
+
+template<typename T, std::size_t NODE_BYTES>
+BPlusTree<T, NODE_BYTES>::BPlusTree() : root{nullptr}, levels{}, mSize{} {}
+
+
+template<typename T, std::size_t NODE_BYTES>
+BPlusTree<T, NODE_BYTES>::~BPlusTree() {
+    std::vector<std::pair<Node *, std::size_t>> pending;
+    if (root != nullptr) pending.emplace_back(root, 1);
+
+    while (!pending.empty()) {
+        auto [node, level] = pending.back();
+        pending.pop_back();
+
+        if (level == levels) {
+            delete node;
+            continue;
+        }
+
+        auto inner = static_cast<Inner *>(node);
+        for (std::uint32_t i = 0; i <= inner->count; i++)
+            pending.emplace_back(inner->children[i], level + 1);
+        delete inner;
+    }
+}
+
+/*
+ * Go down to the leaf remembering the path, insert in the leaf and, while a
+ * node overflows, split it and push its separator up. The root splits last,
+ * so the tree only grows at the top and all the leaves stay at the same depth.
+ *
+ * Equal keys go right of a separator, so the right half of a split always
+ * starts with its separator and contains() finds duplicates that straddle it.
+ */
+
+template<typename T, std::size_t NODE_BYTES>
+void BPlusTree<T, NODE_BYTES>::insert(const T &item) {
+    if (root == nullptr) {
+        root = new Node;
+        levels = 1;
+    }
+
+    path.clear();
+    auto node = root;
+    for (std::size_t level = 1; level < levels; level++) {
+        auto inner = static_cast<Inner *>(node);
+        auto position = upperBound(inner, item);
+        path.emplace_back(inner, position);
+        node = inner->children[position];
+    }
+
+    mSize++;
+    auto position = upperBound(node, item);
+    if (node->count < capacity) {
+        insertAt(node, position, item);
+        return;
+    }
+
+    constexpr std::uint32_t half = capacity / 2;
+    auto right = new Node;
+    std::copy(node->keys + half, node->keys + capacity, right->keys);
+    right->count = capacity - half;
+    truncate(node, half);
+    if (position <= half) insertAt(node, position, item);
+    else insertAt(right, position - half, item);
+
+    T separator = right->keys[0];
+    Node *child = right;
+
+    while (!path.empty()) {
+        auto [parent, index] = path.back();
+        path.pop_back();
+
+        if (parent->count < capacity) {
+            insertAt(parent, index, separator, child);
+            return;
+        }
+
+        /*
+         * capacity + 1 separators: the middle one goes up, the ones after it
+         * (and their children) move to the new sibling
+         */
+        T keys[capacity + 1];
+        Node *children[capacity + 2];
+        std::copy(parent->keys, parent->keys + index, keys);
+        keys[index] = separator;
+        std::copy(parent->keys + index, parent->keys + capacity, keys + index + 1);
+        std::copy(parent->children, parent->children + index + 1, children);
+        children[index + 1] = child;
+        std::copy(parent->children + index + 1, parent->children + capacity + 1, children + index + 2);
+
+        constexpr std::uint32_t middle = (capacity + 1) / 2;
+        auto sibling = new Inner;
+        std::copy(keys, keys + middle, parent->keys);
+        truncate(parent, middle);
+        std::copy(children, children + middle + 1, parent->children);
+        sibling->count = capacity - middle;
+        std::copy(keys + middle + 1, keys + capacity + 1, sibling->keys);
+        std::copy(children + middle + 1, children + capacity + 2, sibling->children);
+
+        separator = keys[middle];
+        child = sibling;
+    }
+
+    auto newRoot = new Inner;
+    newRoot->count = 1;
+    newRoot->keys[0] = separator;
+    newRoot->children[0] = root;
+    newRoot->children[1] = child;
+    root = newRoot;
+    levels++;
+}
+
+
+template<typename T, std::size_t NODE_BYTES>
+bool BPlusTree<T, NODE_BYTES>::contains(const T &item) const {
+    if (root == nullptr) return false;
+
+    auto node = leaf(item);
+    auto position = lowerBound(node, item);
+    return position < node->count && !(item < node->keys[position]);
+}
+
+/*
+ * The first key of the leftmost leaf and the last key of the rightmost one
+ */
+
+template<typename T, std::size_t NODE_BYTES>
+T BPlusTree<T, NODE_BYTES>::min() const {
+    if (isEmpty()) throw std::runtime_error{"Empty Tree"};
+
+    auto node = root;
+    for (std::size_t level = 1; level < levels; level++)
+        node = static_cast<const Inner *>(node)->children[0];
+    return node->keys[0];
+}
+
+template<typename T, std::size_t NODE_BYTES>
+T BPlusTree<T, NODE_BYTES>::max() const {
+    if (isEmpty()) throw std::runtime_error{"Empty Tree"};
+
+    auto node = root;
+    for (std::size_t level = 1; level < levels; level++)
+        node = static_cast<const Inner *>(node)->children[node->count];
+    return node->keys[node->count - 1];
+}
+
+
+template<typename T, std::size_t NODE_BYTES>
+std::size_t BPlusTree<T, NODE_BYTES>::height() const {
+    return levels;
+}
+
+template<typename T, std::size_t NODE_BYTES>
+std::size_t BPlusTree<T, NODE_BYTES>::size() const {
+    return mSize;
+}
+
+template<typename T, std::size_t NODE_BYTES>
+bool BPlusTree<T, NODE_BYTES>::isEmpty() const {
+    return mSize == 0;
+}
+
+/*
+ * A node is one contiguous run of keys, so counting the keys on the left of
+ * item (no early exit, no branch) is cheaper than a binary search: the loop
+ * becomes a few vector compares and the memory is already in the cache.
+ * Arithmetic keys are scanned over the whole padded array, a fixed trip count
+ * the compiler can vectorize; a padding slot is never less than item and is
+ * not greater only when item is the largest value, hence the min with count.
+ */
+
+template<typename T, std::size_t NODE_BYTES>
+std::uint32_t BPlusTree<T, NODE_BYTES>::upperBound(const Node *node, const T &item) {
+    std::uint32_t position = 0;
+    if constexpr (std::is_arithmetic_v<T>) {
+        for (std::size_t i = 0; i < capacity; i++)
+            position += !(item < node->keys[i]);
+        return std::min(position, node->count);
+    } else {
+        for (std::uint32_t i = 0; i < node->count; i++)
+            position += !(item < node->keys[i]);
+        return position;
+    }
+}
+
+template<typename T, std::size_t NODE_BYTES>
+std::uint32_t BPlusTree<T, NODE_BYTES>::lowerBound(const Node *node, const T &item) {
+    std::uint32_t position = 0;
+    if constexpr (std::is_arithmetic_v<T>) {
+        for (std::size_t i = 0; i < capacity; i++)
+            position += node->keys[i] < item;
+    } else {
+        for (std::uint32_t i = 0; i < node->count; i++)
+            position += node->keys[i] < item;
+    }
+    return position;
+}
+
+
+template<typename T, std::size_t NODE_BYTES>
+constexpr T BPlusTree<T, NODE_BYTES>::padding() {
+    if constexpr (std::numeric_limits<T>::has_infinity)
+        return std::numeric_limits<T>::infinity();
+    else
+        return std::numeric_limits<T>::max();
+}
+
+
+template<typename T, std::size_t NODE_BYTES>
+void BPlusTree<T, NODE_BYTES>::insertAt(Node *node, std::uint32_t position, const T &item) {
+    std::copy_backward(node->keys + position, node->keys + node->count, node->keys + node->count + 1);
+    node->keys[position] = item;
+    node->count++;
+}
+
+template<typename T, std::size_t NODE_BYTES>
+void BPlusTree<T, NODE_BYTES>::truncate(Node *node, std::uint32_t count) {
+    if constexpr (std::is_arithmetic_v<T>)
+        std::fill(node->keys + count, node->keys + node->count, padding());
+    node->count = count;
+}
+
+/*
+ * separator goes at position and child right after it, next to the child it
+ * was split from
+ */
+template<typename T, std::size_t NODE_BYTES>
+void BPlusTree<T, NODE_BYTES>::insertAt(Inner *node, std::uint32_t position, const T &separator, Node *child) {
+    std::copy_backward(node->children + position + 1, node->children + node->count + 1,
+                       node->children + node->count + 2);
+    node->children[position + 1] = child;
+    insertAt(static_cast<Node *>(node), position, separator);
+}
+
+
+template<typename T, std::size_t NODE_BYTES>
+const typename BPlusTree<T, NODE_BYTES>::Node *BPlusTree<T, NODE_BYTES>::leaf(const T &item) const {
+    const Node *node = root;
+    for (std::size_t level = 1; level < levels; level++)
+        node = static_cast<const Inner *>(node)->children[upperBound(node, item)];
+    return node;
+}
+
+#endif //DATA__STRUCTURES_BPLUSTREE_CPP
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ * -> B+ Trees Applications:
+ *  1. Databases and file systems indexes
+ *  2. In memory sorted sets too big for the cache
+ *
+ * B+ Tree (Type of Tree)
+ *
+ * Tree and AVLTree allocate one node per value with two child pointers, so a
+ * look up in a big tree is one cache miss per level (~24 for 10M values).
+ * Here a node holds up to `capacity` sorted keys and their count in NODE_BYTES,
+ * aligned on a cache line: the tree is capacity / 2 to capacity times
+ * shallower. The keys of a node are scanned with a branchless loop of fixed
+ * length that gcc vectorizes at -O2 for keys of 32 bits or less (64-bit
+ * integers need SSE4.2, e.g. -march=native). All the values are in the leaves,
+ * the inner nodes only hold separators.
+ *
+ * -> Features, being N the number of elements and B the node capacity:
+ * 1. Look Up O(log_B(N)) cache misses, O(B) comparisons per node
+ * 2. Insert O(log_B(N)) cache misses, a full node is split in two
+ * 3. Min and Max O(log_B(N))
+ * 4. All the leaves are at the same depth, nodes are at least half full
+ *
+ * https://en.wikipedia.org/wiki/B%2B_tree
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_BPLUSTREE_H
+#define DATA__STRUCTURES_BPLUSTREE_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <type_traits>
+
+template<typename T, std::size_t NODE_BYTES = 256>
+class BPlusTree {
+
+public:
+
+    using ValueType = T;
+
+    /*
+     * Keys per node: what fits in NODE_BYTES next to the count, rounded down to
+     * whole 16-byte vectors so the scan has no scalar tail. NODE_BYTES = 256
+     * (4 cache lines) is 60 ints.
+     */
+    static constexpr std::size_t lanes = std::max<std::size_t>(16 / sizeof(T), 1);
+    static constexpr std::size_t capacity =
+            std::max<std::size_t>((NODE_BYTES - sizeof(std::uint32_t)) / sizeof(T) / lanes * lanes, 4);
+
+public:
+
+    BPlusTree();
+
+    ~BPlusTree();
+
+    BPlusTree(const BPlusTree &other) = delete;
+
+    BPlusTree &operator=(const BPlusTree &other) = delete;
+
+public:
+
+    /*
+     * Same surface as Tree: duplicates are kept
+     */
+    void insert(const T &item);
+
+    bool contains(const T &item) const;
+
+    T min() const;
+
+    T max() const;
+
+    /*
+     * Number of levels, leaves included
+     */
+    std::size_t height() const;
+
+    std::size_t size() const;
+
+    bool isEmpty() const;
+
+private:
+
+    /*
+     * A leaf is a bare Node, an Inner node with `count` separators has
+     * count + 1 children; the kind of a node is known from its depth. For
+     * arithmetic keys the free slots hold padding(), so the scan can always
+     * read the whole array.
+     */
+    struct alignas(64) Node {
+        Node() {
+            if constexpr (std::is_arithmetic_v<T>)
+                std::fill(keys, keys + capacity, padding());
+        }
+
+        std::uint32_t count{};
+        T keys[capacity];
+    };
+
+    struct Inner : Node {
+        Node *children[capacity + 1];
+    };
+
+private:
+
+    Node *root;
+    std::size_t levels;
+    std::size_t mSize;
+    std::vector<std::pair<Inner *, std::uint32_t>> path;
+
+private:
+
+    /*
+     * Number of keys <= item (< item), without branches
+     */
+    static std::uint32_t upperBound(const Node *node, const T &item);
+
+    static std::uint32_t lowerBound(const Node *node, const T &item);
+
+    /*
+     * The largest value of T, infinity for floating point
+     */
+    static constexpr T padding();
+
+    static void insertAt(Node *node, std::uint32_t position, const T &item);
+
+    /*
+     * Keeps the first count keys and pads the rest again
+     */
+    static void truncate(Node *node, std::uint32_t count);
+
+    static void insertAt(Inner *node, std::uint32_t position, const T &separator, Node *child);
+
+    const Node *leaf(const T &item) const;
+};
+
+
+#endif //DATA__STRUCTURES_BPLUSTREE_H
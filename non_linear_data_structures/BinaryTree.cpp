@@ -31,10 +31,29 @@
  * Constructor and Destructor
  */
 template<typename T>
-Tree<T>::Tree() : root{nullptr}, mSize{} {}
+Tree<T>::Tree(Balancing balancing) : root{nullptr}, mSize{}, balancing{balancing}, seed{0x9E3779B97F4A7C15ull} {}
 
 template<typename T>
-Tree<T>::~Tree() { delete root; }
+Tree<T>::~Tree() {
+    clear();
+}
+
+template<typename T>
+void Tree<T>::clear() {
+    std::vector<Node *> pending;
+    if (root != nullptr) pending.push_back(root);
+
+    while (!pending.empty()) {
+        auto node = pending.back();
+        pending.pop_back();
+        if (node->leftChild != nullptr) pending.push_back(node->leftChild);
+        if (node->rightChild != nullptr) pending.push_back(node->rightChild);
+        delete node;
+    }
+
+    root = nullptr;
+    mSize = 0;
+}
 
 
 /*
@@ -43,6 +62,31 @@ Tree<T>::~Tree() { delete root; }
 
 template<typename T>
 void Tree<T>::insert(T item) {
+    if (balancing == Balancing::Treap) {
+        Node *node = new Node{item, nextPriority()};
+        Node **link = &root;
+
+        path.clear();
+        while (*link != nullptr) {
+            path.push_back(link);
+            link = item < (*link)->value ? &(*link)->leftChild : &(*link)->rightChild;
+        }
+        *link = node;
+
+        /*
+         * The new leaf goes up by rotations while its priority beats its parent's
+         */
+        while (!path.empty() && (*path.back())->priority < node->priority) {
+            auto parentLink = path.back();
+            path.pop_back();
+            if ((*parentLink)->leftChild == node) rotateRight(parentLink);
+            else rotateLeft(parentLink);
+        }
+
+        mSize++;
+        return;
+    }
+
     Node *node = new Node{item};
     if (root == nullptr) root = node;
     else {
@@ -66,6 +110,177 @@ void Tree<T>::insert(T item) {
     mSize++;
 }
 
+/*
+ * Removing a node from the binary search tree.
+ * Treap: the node is rotated down (its higher priority child taking its place)
+ * until it has at most one child, then replaced by that child.
+ * None: a node with two children takes the value of its successor (the minimum
+ * of its right subtree), which is removed instead.
+ */
+
+template<typename T>
+bool Tree<T>::remove(T item) {
+    Node **link = &root;
+    while (*link != nullptr && (*link)->value != item)
+        link = item < (*link)->value ? &(*link)->leftChild : &(*link)->rightChild;
+
+    if (*link == nullptr) return false;
+
+    Node *node = *link;
+    if (node->leftChild != nullptr && node->rightChild != nullptr) {
+        if (balancing == Balancing::Treap) {
+            while (node->leftChild != nullptr && node->rightChild != nullptr) {
+                if (node->leftChild->priority > node->rightChild->priority) {
+                    rotateRight(link);
+                    link = &(*link)->rightChild;
+                } else {
+                    rotateLeft(link);
+                    link = &(*link)->leftChild;
+                }
+            }
+        } else {
+            link = &node->rightChild;
+            while ((*link)->leftChild != nullptr)
+                link = &(*link)->leftChild;
+            node->value = (*link)->value;
+            node = *link;
+        }
+    }
+
+    *link = node->leftChild != nullptr ? node->leftChild : node->rightChild;
+    delete node;
+    mSize--;
+    return true;
+}
+
+/*
+ * Bulk construction: the middle value is the root and both halves are built
+ * the same way, the left half by a new thread while there are threads left
+ * and the range is big enough. A Treap node gets max - depth as priority, so
+ * every parent beats its children and later inserts (random priorities) stay
+ * below the bulk loaded nodes.
+ */
+
+template<typename T>
+template<typename Iterator>
+void Tree<T>::fromSorted(Iterator begin, Iterator end, unsigned threads) {
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+    if constexpr (!std::is_base_of_v<std::random_access_iterator_tag, Category>) {
+        std::vector<T> values(begin, end);
+        fromSorted(values.begin(), values.end(), threads);
+    } else {
+        if (!std::is_sorted(begin, end)) throw std::runtime_error{"Values are not sorted"};
+
+        clear();
+        auto make = [begin](std::size_t index) { return new Node{begin[index]}; };
+        mSize = static_cast<std::size_t>(end - begin);
+        root = build(0, mSize, make, 0, std::max(threads, 1u));
+    }
+}
+
+/*
+ * Both trees are flattened in order, merged like two sorted arrays and the
+ * same nodes are linked again into one balanced tree
+ */
+
+template<typename T>
+void Tree<T>::merge(Tree<T> &other, unsigned threads) {
+    if (&other == this || other.root == nullptr) return;
+
+    std::vector<Node *> mine, theirs, nodes(mSize + other.mSize);
+    mine.reserve(mSize);
+    theirs.reserve(other.mSize);
+    flatten(root, mine);
+    flatten(other.root, theirs);
+    std::merge(mine.begin(), mine.end(), theirs.begin(), theirs.end(), nodes.begin(),
+               [](const Node *a, const Node *b) { return a->value < b->value; });
+
+    auto make = [&nodes](std::size_t index) { return nodes[index]; };
+    mSize = nodes.size();
+    root = build(0, mSize, make, 0, std::max(threads, 1u));
+
+    other.root = nullptr;
+    other.mSize = 0;
+}
+
+template<typename T>
+template<typename Make>
+typename Tree<T>::Node *Tree<T>::build(std::size_t first, std::size_t count, Make &make, std::uint32_t depth, unsigned threads) {
+    if (count == 0)
+        return nullptr;
+
+    auto leftCount = count / 2;
+    Node *node = make(first + leftCount);
+    node->priority = balancing == Balancing::Treap ? std::numeric_limits<std::uint32_t>::max() - depth : 0;
+
+    if (threads > 1 && count >= minimumChunk) {
+        std::thread worker{[&, threads]() { node->leftChild = build(first, leftCount, make, depth + 1, threads / 2); }};
+        node->rightChild = build(first + leftCount + 1, count - leftCount - 1, make, depth + 1, threads - threads / 2);
+        worker.join();
+    } else {
+        node->leftChild = build(first, leftCount, make, depth + 1, 1);
+        node->rightChild = build(first + leftCount + 1, count - leftCount - 1, make, depth + 1, 1);
+    }
+
+    return node;
+}
+
+template<typename T>
+void Tree<T>::flatten(Node *rootNode, std::vector<Node *> &nodes) {
+    std::vector<Node *> pending;
+
+    for (Node *current = rootNode; current != nullptr || !pending.empty();) {
+        for (; current != nullptr; current = current->leftChild)
+            pending.push_back(current);
+
+        current = pending.back();
+        pending.pop_back();
+        nodes.push_back(current);
+        current = current->rightChild;
+    }
+}
+
+/*
+ * xorshift64*, the high half
+ */
+
+template<typename T>
+std::uint32_t Tree<T>::nextPriority() {
+    seed ^= seed >> 12;
+    seed ^= seed << 25;
+    seed ^= seed >> 27;
+    return static_cast<std::uint32_t>((seed * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+/*
+ * Rotations keep the in-order sequence, the node at *link changes
+ *
+ *        n                  r
+ *       / \     left       / \
+ *      a   r    ----->    n   c
+ *         / \            / \
+ *        b   c          a   b
+ */
+
+template<typename T>
+void Tree<T>::rotateLeft(Node **link) {
+    Node *node = *link;
+    Node *right = node->rightChild;
+    node->rightChild = right->leftChild;
+    right->leftChild = node;
+    *link = right;
+}
+
+template<typename T>
+void Tree<T>::rotateRight(Node **link) {
+    Node *node = *link;
+    Node *left = node->leftChild;
+    node->leftChild = left->rightChild;
+    left->rightChild = node;
+    *link = left;
+}
+
 template<typename T>
 bool Tree<T>::isRightLeaf(const Node *current) const { return current->rightChild == nullptr; }
 
@@ -153,8 +368,8 @@ void Tree<T>::levelOrderTraversal() const {
 }
 
 /*
- * Using post-order-traversal to get the height the tree.
- * Using the formula H = 1 + max(Height(Left), Height(Right)).
+ * Counting the levels of a level-order traversal, so a degenerate tree (a
+ * plain BST filled in sorted order) does not recurse N calls deep.
  */
 
 template<typename T>
@@ -165,13 +380,26 @@ size_t Tree<T>::height() const {
 
 template<typename T>
 size_t Tree<T>::height(Node *rootNode) const {
-    if (isLeaf(rootNode)) return 0;
+    std::queue<Node *> level;
+    size_t levels{};
+
+    level.push(rootNode);
+    while (!level.empty()) {
+        for (auto count = level.size(); count > 0; count--) {
+            auto node = level.front();
+            level.pop();
+            if (node->leftChild != nullptr) level.push(node->leftChild);
+            if (node->rightChild != nullptr) level.push(node->rightChild);
+        }
+        levels++;
+    }
 
-    return 1 + std::max(height(rootNode->leftChild), height(rootNode->rightChild));
+    return levels - 1;
 }
 
 /*
- * Getting the min and max values in a binary tree.
+ * Getting the min and max values in a binary search tree: the leftmost and the
+ * rightmost nodes.
  */
 
 template<typename T>
@@ -182,8 +410,8 @@ T Tree<T>::min() const {
 
 template<typename T>
 T Tree<T>::min(Node *rootNode) const {
-    if (isLeaf(rootNode)) return rootNode->value;
-    return std::min(std::min(min(rootNode->leftChild), min(rootNode->rightChild)), rootNode->value);
+    while (rootNode->leftChild != nullptr) rootNode = rootNode->leftChild;
+    return rootNode->value;
 }
 
 template<typename T>
@@ -194,8 +422,8 @@ T Tree<T>::max() const {
 
 template<typename T>
 T Tree<T>::max(Node *rootNode) const {
-    if (isLeaf(rootNode)) return rootNode->value;
-    return std::max(std::max(max(rootNode->leftChild), max(rootNode->rightChild)), rootNode->value);
+    while (rootNode->rightChild != nullptr) rootNode = rootNode->rightChild;
+    return rootNode->value;
 }
 
 /*
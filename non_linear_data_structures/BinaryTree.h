@@ -18,6 +18,17 @@
  * 3. Insert O(log N)
  * NOTE: if the tree is not well structured performance may degrade to O(n).
  *
+ * -> Balancing::Treap keeps it well structured whatever the insertion order
+ *    (sorted keys included): every node gets a random priority and the tree is
+ *    also a max heap on priorities, which makes its shape the one of a BST
+ *    built from a random permutation, expected height O(log N).
+ *
+ * -> fromSorted / merge build a perfectly balanced tree in O(N) in both modes;
+ *    a Treap gets its priorities from the depth (the root the highest), which
+ *    keeps the heap order.
+ *
+ * https://en.wikipedia.org/wiki/Treap
+ *
  * https://en.wikipedia.org/wiki/Tree
  * https://en.wikipedia.org/wiki/Binary_tree
  *
@@ -30,6 +41,14 @@
 
 #include <iostream>
 #include <limits>
+#include <vector>
+#include <queue>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <type_traits>
 
 
 template<typename TREE>
@@ -40,13 +59,14 @@ public:
 
 public:
 
-    explicit Node(T v) : value{v}, leftChild{nullptr}, rightChild{nullptr} {}
+    explicit Node(T v, std::uint32_t priority = 0) : value{v}, leftChild{nullptr}, rightChild{nullptr}, priority{priority} {}
 
     Node() = default;
 
     T value;
     Node *leftChild;
     Node *rightChild;
+    std::uint32_t priority;
 };
 
 template<typename T>
@@ -54,9 +74,16 @@ class Tree {
 public:
     using ValueType = T;
     using Node = Node<Tree<T>>;
+
+    /*
+     * None: plain binary search tree, the shape follows the insertion order
+     * Treap: randomized balancing, O(log N) expected for insert / remove / find
+     */
+    enum class Balancing { None, Treap };
+
 public:
 
-    Tree();
+    explicit Tree(Balancing balancing = Balancing::None);
 
     ~Tree();
 
@@ -67,8 +94,23 @@ public:
      */
     void insert(T item);
 
+    /*
+     * Removes one occurrence of item, returns false if there is none
+     */
+    bool remove(T item);
+
     bool find(T item);
 
+    /*
+     * fromSorted: replaces the content with the values of [begin, end), which
+     * must be sorted; the subtrees are built by up to `threads` threads
+     * merge: moves the nodes of other into this tree, other ends up empty
+     */
+    template<typename Iterator>
+    void fromSorted(Iterator begin, Iterator end, unsigned threads = 1);
+
+    void merge(Tree<T> &other, unsigned threads = 1);
+
     bool contains(T item) const;
 
     /*
@@ -123,10 +165,32 @@ public:
     }
 
 private:
+    static constexpr std::size_t minimumChunk = 1 << 14;
+
     Node *root;
     std::size_t mSize;
+    Balancing balancing;
+    std::uint64_t seed;
+    std::vector<Node **> path;
 
 private:
+    std::uint32_t nextPriority();
+
+    void clear();
+
+    /*
+     * Balanced subtree over the nodes make(first) .. make(first + count - 1),
+     * taken in order, its root at depth
+     */
+    template<typename Make>
+    Node *build(std::size_t first, std::size_t count, Make &make, std::uint32_t depth, unsigned threads);
+
+    static void flatten(Node *rootNode, std::vector<Node *> &nodes);
+
+    static void rotateLeft(Node **link);
+
+    static void rotateRight(Node **link);
+
     void preOrderTraversal(Node *rootNode) const;
 
     void inOrderTraversal(Node *rootNode) const;
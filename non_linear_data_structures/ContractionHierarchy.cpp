@@ -0,0 +1,341 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Contraction Hierarchy (shortest path index of a static undirected graph)
+ *
+ * https://en.wikipedia.org/wiki/Contraction_hierarchies
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_CONTRACTIONHIERARCHY_CPP
+#define DATA__STRUCTURES_CONTRACTIONHIERARCHY_CPP
+
+#include "ContractionHierarchy.h"
+
+
+template<typename T>
+void ContractionHierarchy<T>::Search::reset(std::size_t size) {
+    distances.resize(size);
+    previous.resize(size);
+    reached.resize(size, 0);
+    heap.clear();
+    heap.resize(size);
+    if (++epoch == 0) {
+        std::fill(reached.begin(), reached.end(), 0);
+        epoch = 1;
+    }
+}
+
+template<typename T>
+int ContractionHierarchy<T>::Search::distance(Index index) const {
+    return reached[index] == epoch ? distances[index] : std::numeric_limits<int>::max();
+}
+
+template<typename T>
+typename ContractionHierarchy<T>::Index ContractionHierarchy<T>::Search::previousOf(Index index) const {
+    return reached[index] == epoch ? previous[index] : npos;
+}
+
+template<typename T>
+void ContractionHierarchy<T>::Search::relax(Index index, int distance, Index previousNode) {
+    distances[index] = distance;
+    previous[index] = previousNode;
+    reached[index] = epoch;
+}
+
+/*
+ * Preprocessing. The vertices sit in an indexed heap keyed by their priority;
+ * priorities only change around contracted vertices, so they are refreshed
+ * lazily: the head is re-evaluated and pushed back if it is no longer the
+ * minimum.
+ */
+
+template<typename T>
+ContractionHierarchy<T>::ContractionHierarchy(const CsrGraph<T> &graph, std::size_t witnessLimit)
+        : graph{graph}, rank(graph.nodeCount(), npos), shortcuts{} {
+
+    if (graph.isDirected())
+        throw std::runtime_error{"Contraction hierarchies need an undirected graph"};
+
+    auto size = graph.nodeCount();
+    std::vector<std::vector<Arc>> arcs(size);
+    std::vector<char> contracted(size, false);
+    std::vector<int> contractedNeighbors(size, 0);
+    Search witness;
+
+    for (Index node = 0; node < size; node++)
+        for (auto edge = graph.firstEdge(node); edge < graph.lastEdge(node); edge++)
+            if (graph.target(edge) != node)
+                addArc(arcs, node, graph.target(edge), graph.weight(edge), npos);
+
+    auto priority = [&](Index node) {
+        int degree{};
+        for (auto &arc : arcs[node])
+            if (!contracted[arc.to])
+                degree++;
+
+        auto added = static_cast<int>(contract(arcs, contracted, node, witnessLimit, witness, true));
+        return added - degree + contractedNeighbors[node];
+    };
+
+    IndexedHeap<int> queue(size);
+    for (Index node = 0; node < size; node++)
+        queue.insert(node, priority(node));
+
+    Index nextRank{};
+    while (!queue.isEmpty()) {
+        auto node = static_cast<Index>(queue.remove());
+        auto current = priority(node);
+
+        if (!queue.isEmpty() && current > queue.getMin()) {
+            queue.insert(node, current);
+            continue;
+        }
+
+        shortcuts += contract(arcs, contracted, node, witnessLimit, witness, false);
+        contracted[node] = true;
+        rank[node] = nextRank++;
+
+        for (auto &arc : arcs[node])
+            if (!contracted[arc.to])
+                contractedNeighbors[arc.to]++;
+    }
+
+    /*
+     * Upward graph in CSR form: every arc is stored at its lower ranked end.
+     */
+    upOffsets.push_back(0);
+    for (Index node = 0; node < size; node++) {
+        for (auto &arc : arcs[node])
+            if (rank[arc.to] > rank[node])
+                upArcs.push_back(arc);
+        upOffsets.push_back(upArcs.size());
+    }
+}
+
+/*
+ * Parallel arcs are merged, only the lightest one is kept.
+ */
+
+template<typename T>
+void ContractionHierarchy<T>::addArc(std::vector<std::vector<Arc>> &arcs, Index from, Index to, int weight, Index middle) {
+    for (auto &arc : arcs[from]) {
+        if (arc.to == to) {
+            if (weight < arc.weight) {
+                arc.weight = weight;
+                arc.middle = middle;
+            }
+            return;
+        }
+    }
+    arcs[from].push_back(Arc{to, weight, middle});
+}
+
+/*
+ * For every pair of remaining neighbors u, w of `node`, a shortcut u - w is
+ * needed unless a witness search from u (avoiding `node`) finds a path no
+ * longer than u - node - w. Returns the number of shortcuts; with `simulate`
+ * nothing is added (used to compute the priority).
+ */
+
+template<typename T>
+std::size_t ContractionHierarchy<T>::contract(std::vector<std::vector<Arc>> &arcs, const std::vector<char> &contracted,
+                                              Index node, std::size_t witnessLimit, Search &witness, bool simulate) {
+    std::vector<Arc> neighbors;
+    int maxWeight{};
+    for (auto &arc : arcs[node]) {
+        if (!contracted[arc.to]) {
+            neighbors.push_back(arc);
+            maxWeight = std::max(maxWeight, arc.weight);
+        }
+    }
+
+    std::size_t added{};
+    for (auto &in : neighbors) {
+        witnessSearch(arcs, contracted, in.to, node, in.weight + maxWeight, witnessLimit, witness);
+
+        for (auto &out : neighbors) {
+            if (out.to == in.to)
+                continue;
+
+            auto through = in.weight + out.weight;
+            if (witness.distance(out.to) <= through)
+                continue;
+
+            added++;
+            if (!simulate) {
+                addArc(arcs, in.to, out.to, through, node);
+                addArc(arcs, out.to, in.to, through, node);
+            }
+        }
+    }
+
+    return added;
+}
+
+
+template<typename T>
+void ContractionHierarchy<T>::witnessSearch(const std::vector<std::vector<Arc>> &arcs, const std::vector<char> &contracted,
+                                            Index source, Index ignored, int maxDistance, std::size_t witnessLimit,
+                                            Search &witness) {
+    auto &heap = witness.heap;
+    std::size_t settled{};
+
+    witness.reset(arcs.size());
+    witness.relax(source, 0, npos);
+    heap.insert(source, 0);
+
+    while (!heap.isEmpty() && settled++ < witnessLimit) {
+        if (heap.getMin() > maxDistance)
+            break;
+
+        auto current = static_cast<Index>(heap.remove());
+        for (auto &arc : arcs[current]) {
+            if (arc.to == ignored || contracted[arc.to])
+                continue;
+
+            auto distance = witness.distance(current) + arc.weight;
+            if (distance < witness.distance(arc.to)) {
+                witness.relax(arc.to, distance, current);
+                heap.update(arc.to, distance);
+            }
+        }
+    }
+}
+
+/*
+ * Bidirectional upward search. A side stops once its queue head is not shorter
+ * than the best meeting found so far.
+ */
+
+template<typename T>
+Path ContractionHierarchy<T>::getShortestDistance(const T &from, const T &to) {
+    auto source = graph.indexOf(from);
+    auto target = graph.indexOf(to);
+
+    forward.reset(nodeCount());
+    backward.reset(nodeCount());
+    forward.relax(source, 0, npos);
+    forward.heap.insert(source, 0);
+    backward.relax(target, 0, npos);
+    backward.heap.insert(target, 0);
+
+    int best = std::numeric_limits<int>::max();
+    Index meeting = npos;
+
+    while (true) {
+        auto forwardMoved = settleUpward(forward, backward, best, meeting);
+        auto backwardMoved = settleUpward(backward, forward, best, meeting);
+        if (!forwardMoved && !backwardMoved)
+            break;
+    }
+
+    Path path;
+    if (meeting == npos) {
+        path.addNode(to);
+        return path;
+    }
+
+    std::vector<Index> up;
+    for (auto current = meeting; current != npos; current = forward.previousOf(current))
+        up.push_back(current);
+    std::reverse(up.begin(), up.end());
+
+    std::vector<Index> nodes{source};
+    for (std::size_t i = 1; i < up.size(); i++)
+        unpack(up[i - 1], up[i], nodes);
+    for (auto current = meeting; backward.previousOf(current) != npos; current = backward.previousOf(current))
+        unpack(current, backward.previousOf(current), nodes);
+
+    for (auto node : nodes)
+        path.addNode(graph.label(node));
+    return path;
+}
+
+
+template<typename T>
+bool ContractionHierarchy<T>::settleUpward(Search &search, const Search &other, int &best, Index &meeting) {
+    if (search.heap.isEmpty() || search.heap.getMin() >= best) {
+        search.heap.clear();
+        return false;
+    }
+
+    auto current = static_cast<Index>(search.heap.remove());
+    auto otherDistance = other.distance(current);
+    if (otherDistance != std::numeric_limits<int>::max() && search.distance(current) + otherDistance < best) {
+        best = search.distance(current) + otherDistance;
+        meeting = current;
+    }
+
+    for (auto i = upOffsets[current]; i < upOffsets[current + 1]; i++) {
+        auto &arc = upArcs[i];
+        auto distance = search.distance(current) + arc.weight;
+        if (distance < search.distance(arc.to)) {
+            search.relax(arc.to, distance, current);
+            search.heap.update(arc.to, distance);
+        }
+    }
+    return true;
+}
+
+/*
+ * The arc between two vertices lives at the lower ranked one.
+ */
+
+template<typename T>
+typename ContractionHierarchy<T>::Index ContractionHierarchy<T>::middleOf(Index from, Index to) const {
+    auto low = rank[from] < rank[to] ? from : to;
+    auto high = low == from ? to : from;
+
+    for (auto i = upOffsets[low]; i < upOffsets[low + 1]; i++)
+        if (upArcs[i].to == high)
+            return upArcs[i].middle;
+
+    throw std::runtime_error{"No such arc"};
+}
+
+/*
+ * Appends the original vertices of the arc from -> to (without `from`). A
+ * shortcut is replaced by its two halves; an explicit stack is used because
+ * shortcuts of shortcuts can nest deeply.
+ */
+
+template<typename T>
+void ContractionHierarchy<T>::unpack(Index from, Index to, std::vector<Index> &path) const {
+    std::vector<std::pair<Index, Index>> stack{{from, to}};
+
+    while (!stack.empty()) {
+        auto [first, second] = stack.back();
+        stack.pop_back();
+
+        auto middle = middleOf(first, second);
+        if (middle == npos) {
+            path.push_back(second);
+            continue;
+        }
+
+        stack.emplace_back(middle, second);
+        stack.emplace_back(first, middle);
+    }
+}
+
+
+template<typename T>
+std::size_t ContractionHierarchy<T>::nodeCount() const {
+    return graph.nodeCount();
+}
+
+
+template<typename T>
+std::size_t ContractionHierarchy<T>::shortcutCount() const {
+    return shortcuts;
+}
+
+#endif //DATA__STRUCTURES_CONTRACTIONHIERARCHY_CPP
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Contraction Hierarchy (shortest path index of a static undirected graph)
+ *
+ * Searches and shortcuts assume every edge goes both ways, so a directed graph
+ * is rejected by the constructor.
+ *
+ * -> Preprocessing:
+ *  1. Vertices are ordered by importance (edge difference + contracted neighbors)
+ *  2. They are contracted in that order: removing vertex v adds a shortcut
+ *     u - w (weight(u, v) + weight(v, w)) for every pair of neighbors whose
+ *     shortest path goes through v (no "witness" path avoids it)
+ *  3. Every edge is kept only at its lower ranked end ("upward" graph)
+ *
+ * -> Query: a bidirectional Dijkstra where both searches only go upward, they
+ *    meet at the highest ranked vertex of the shortest path. Shortcuts are then
+ *    unpacked through their middle vertex into the original path.
+ *
+ * -> Features, being V the number of vertices and E the number of edges:
+ *      Preprocessing   O(V * witness searches), done once
+ *      Space           O(V + E + shortcuts)
+ *      Query           explores a few hundred vertices on road networks
+ *                      instead of the whole graph
+ *
+ * https://en.wikipedia.org/wiki/Contraction_hierarchies
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_CONTRACTIONHIERARCHY_H
+#define DATA__STRUCTURES_CONTRACTIONHIERARCHY_H
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "CsrGraph.cpp"
+#include "IndexedHeap.h"
+#include "IndexedHeap.cpp"
+
+template<typename T>
+class ContractionHierarchy {
+
+public:
+
+    using VT = T;
+    using Index = typename CsrGraph<T>::Index;
+
+    static constexpr Index npos = CsrGraph<T>::npos;
+
+public:
+
+    /*
+     * witnessLimit bounds the vertices settled by every witness search: a lower
+     * limit preprocesses faster but may add a few unnecessary shortcuts.
+     */
+    explicit ContractionHierarchy(const CsrGraph<T> &graph, std::size_t witnessLimit = 500);
+
+public:
+
+    Path getShortestDistance(const T &from, const T &to);
+
+    [[nodiscard]] std::size_t nodeCount() const;
+
+    [[nodiscard]] std::size_t shortcutCount() const;
+
+private:
+
+    /*
+     * middle is npos for an original edge, the contracted vertex for a shortcut
+     */
+    struct Arc {
+        Index to;
+        int weight;
+        Index middle;
+    };
+
+    /*
+     * Flat search state reused between searches, see SearchSpace in WeightedGraph
+     */
+    struct Search {
+        std::vector<int> distances;
+        std::vector<Index> previous;
+        std::vector<unsigned> reached;
+        IndexedHeap<int> heap;
+        unsigned epoch{};
+
+        void reset(std::size_t size);
+        [[nodiscard]] int distance(Index index) const;
+        [[nodiscard]] Index previousOf(Index index) const;
+        void relax(Index index, int distance, Index previousNode);
+    };
+
+private:
+
+    CsrGraph<T> graph;
+    std::vector<Index> rank;
+    std::vector<std::size_t> upOffsets;
+    std::vector<Arc> upArcs;
+    std::size_t shortcuts;
+    Search forward;
+    Search backward;
+
+private:
+
+    void addArc(std::vector<std::vector<Arc>> &arcs, Index from, Index to, int weight, Index middle);
+
+    std::size_t contract(std::vector<std::vector<Arc>> &arcs, const std::vector<char> &contracted,
+                         Index node, std::size_t witnessLimit, Search &witness, bool simulate);
+
+    void witnessSearch(const std::vector<std::vector<Arc>> &arcs, const std::vector<char> &contracted,
+                       Index source, Index ignored, int maxDistance, std::size_t witnessLimit, Search &witness);
+
+    bool settleUpward(Search &search, const Search &other, int &best, Index &meeting);
+
+    Index middleOf(Index from, Index to) const;
+
+    void unpack(Index from, Index to, std::vector<Index> &path) const;
+};
+
+
+#endif //DATA__STRUCTURES_CONTRACTIONHIERARCHY_H
@@ -0,0 +1,878 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Compressed Sparse Row Graph (frozen snapshot of a graph)
+ *
+ * -> CSR Applications:
+ *  1. Read-only queries on large graphs (road networks, GPS)
+ *  2. Sparse matrix computations
+ *
+ * -> Layout, being V the number of vertices and E the number of edges:
+ *      - labels     [V]      label of every vertex id (sorted)
+ *      - offsets    [V + 1]  edges of vertex i are [offsets[i], offsets[i + 1])
+ *      - neighbors  [E]      target vertex id of every edge
+ *      - weights    [E]      weight of every edge
+ *
+ * https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_CSRGRAPH_CPP
+#define DATA__STRUCTURES_CSRGRAPH_CPP
+
+#include "CsrGraph.h"
+
+
+template<typename T>
+CsrGraph<T>::CsrGraph(std::vector<T> labels, std::vector<std::size_t> offsets,
+                      std::vector<Index> neighbors, std::vector<int> weights, bool directed)
+        : directed{directed}, labelStorage{std::move(labels)}, offsetStorage{std::move(offsets)},
+          neighborStorage{std::move(neighbors)}, weightStorage{std::move(weights)} {
+
+    if (offsetStorage.size() != labelStorage.size() + 1 || neighborStorage.size() != weightStorage.size())
+        throw std::runtime_error{"Invalid argument"};
+
+    this->labels = labelStorage;
+    this->offsets = offsetStorage;
+    this->neighbors = neighborStorage;
+    this->weights = weightStorage;
+    buildLookup();
+}
+
+
+template<typename T>
+CsrGraph<T>::CsrGraph() : directed{false} {}
+
+/*
+ * A copy shares the mapped file but must point at its own copy of the owned vectors.
+ */
+
+template<typename T>
+CsrGraph<T>::CsrGraph(const CsrGraph &other)
+        : directed{other.directed}, labelStorage{other.labelStorage}, offsetStorage{other.offsetStorage},
+          neighborStorage{other.neighborStorage}, weightStorage{other.weightStorage}, file{other.file},
+          lookup{other.lookup} {
+
+    labels = rebind(other.labels, other.labelStorage, labelStorage);
+    offsets = rebind(other.offsets, other.offsetStorage, offsetStorage);
+    neighbors = rebind(other.neighbors, other.neighborStorage, neighborStorage);
+    weights = rebind(other.weights, other.weightStorage, weightStorage);
+}
+
+
+template<typename T>
+CsrGraph<T> &CsrGraph<T>::operator=(const CsrGraph &other) {
+    if (this != &other) {
+        CsrGraph copy{other};
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<typename T>
+template<typename U>
+std::span<const U> CsrGraph<T>::rebind(std::span<const U> view, const std::vector<U> &from, const std::vector<U> &to) {
+    return view.data() == from.data() ? std::span<const U>{to} : view;
+}
+
+
+template<typename T>
+std::size_t CsrGraph<T>::nodeCount() const {
+    return labels.size();
+}
+
+
+template<typename T>
+std::size_t CsrGraph<T>::edgeCount() const {
+    return neighbors.size();
+}
+
+
+template<typename T>
+bool CsrGraph<T>::isDirected() const {
+    return directed;
+}
+
+/*
+ * A binary search over the labels, or over the ids sorted by label when the
+ * labels are not in order.
+ */
+
+template<typename T>
+typename CsrGraph<T>::Index CsrGraph<T>::indexOf(const T &label) const {
+    if (lookup.empty()) {
+        auto itr = std::lower_bound(labels.begin(), labels.end(), label);
+
+        if (itr == labels.end() || *itr != label)
+            throw std::runtime_error{"No such element"};
+
+        return static_cast<Index>(itr - labels.begin());
+    }
+
+    auto itr = std::lower_bound(lookup.begin(), lookup.end(), label,
+                                [this](Index id, const T &value) { return labels[id] < value; });
+
+    if (itr == lookup.end() || labels[*itr] != label)
+        throw std::runtime_error{"No such element"};
+
+    return *itr;
+}
+
+
+template<typename T>
+void CsrGraph<T>::buildLookup() {
+    lookup.clear();
+    if (std::is_sorted(labels.begin(), labels.end()))
+        return;
+
+    lookup.resize(labels.size());
+    for (Index id = 0; id < labels.size(); id++)
+        lookup[id] = id;
+    std::sort(lookup.begin(), lookup.end(), [this](Index lhs, Index rhs) { return labels[lhs] < labels[rhs]; });
+}
+
+
+template<typename T>
+const T &CsrGraph<T>::label(Index index) const {
+    if (index >= labels.size()) throw std::runtime_error{"Index out of range"};
+    return labels[index];
+}
+
+
+template<typename T>
+std::size_t CsrGraph<T>::firstEdge(Index node) const {
+    return offsets[node];
+}
+
+
+template<typename T>
+std::size_t CsrGraph<T>::lastEdge(Index node) const {
+    return offsets[node + 1];
+}
+
+
+template<typename T>
+typename CsrGraph<T>::Index CsrGraph<T>::target(std::size_t edge) const {
+    return neighbors[edge];
+}
+
+
+template<typename T>
+int CsrGraph<T>::weight(std::size_t edge) const {
+    return weights[edge];
+}
+
+/*
+ * Every section is padded to 8 bytes so open() can point typed spans at it.
+ */
+
+template<typename T>
+void CsrGraph<T>::save(const std::string &path) const {
+    static_assert(std::is_same_v<T, std::string> || std::is_trivially_copyable_v<T>,
+                  "Only std::string and trivially copyable labels can be saved");
+
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (!out) throw std::runtime_error{"Cannot open " + path};
+
+    std::vector<std::uint64_t> labelOffsets{0};
+    if constexpr (std::is_same_v<T, std::string>)
+        for (auto &label : labels)
+            labelOffsets.push_back(labelOffsets.back() + label.size());
+
+    std::uint32_t header[5] = {version, directed, std::is_same_v<T, std::string> ? 1u : 0u, sizeof(T), 0};
+    std::uint64_t sizes[3] = {nodeCount(), edgeCount(), 0};
+    sizes[2] = std::is_same_v<T, std::string> ? labelOffsets.back() : nodeCount() * sizeof(T);
+
+    out.write("CSRG", 4);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    writeSection(out, sizes, 3);
+
+    if constexpr (std::is_same_v<T, std::string>) {
+        writeSection(out, labelOffsets.data(), labelOffsets.size());
+        std::string characters;
+        for (auto &label : labels)
+            characters += label;
+        writeSection(out, characters.data(), characters.size());
+    } else {
+        writeSection(out, labels.data(), labels.size());
+    }
+
+    static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "Offsets are stored as 64-bit integers");
+    writeSection(out, offsets.data(), offsets.size());
+    writeSection(out, neighbors.data(), neighbors.size());
+    writeSection(out, weights.data(), weights.size());
+
+    if (!out) throw std::runtime_error{"Cannot write " + path};
+}
+
+
+template<typename T>
+CsrGraph<T> CsrGraph<T>::open(const std::string &path) {
+    auto mapped = std::make_shared<const MappedFile>(path);
+    constexpr std::size_t headerSize = 4 + 5 * sizeof(std::uint32_t);
+
+    std::uint32_t header[5]{};
+    if (mapped->size() < headerSize || std::memcmp(mapped->data(), "CSRG", 4) != 0)
+        throw std::runtime_error{"Not a graph file " + path};
+    std::memcpy(header, mapped->data() + 4, sizeof(header));
+
+    std::size_t position = headerSize;
+    auto sizes = section<std::uint64_t>(*mapped, position, 3);
+    auto nodes = sizes[0], edges = sizes[1], labelBytes = sizes[2];
+
+    if (header[0] != version)
+        throw std::runtime_error{"Unsupported graph file version " + path};
+    if (nodes >= npos)
+        throw std::runtime_error{"Corrupt graph file " + path};
+
+    CsrGraph<T> graph;
+    graph.directed = header[1] != 0;
+
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (header[2] != 1) throw std::runtime_error{"Graph file labels are not strings " + path};
+
+        auto labelOffsets = section<std::uint64_t>(*mapped, position, nodes + 1);
+        auto characters = section<char>(*mapped, position, labelBytes);
+        for (std::size_t i = 0; i < nodes; i++)
+            if (labelOffsets[i] > labelOffsets[i + 1] || labelOffsets[i + 1] > labelBytes)
+                throw std::runtime_error{"Corrupt graph file labels " + path};
+
+        graph.labelStorage.reserve(nodes);
+        for (std::size_t i = 0; i < nodes; i++)
+            graph.labelStorage.emplace_back(characters.data() + labelOffsets[i], labelOffsets[i + 1] - labelOffsets[i]);
+        graph.labels = graph.labelStorage;
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>, "Only std::string and trivially copyable labels can be opened");
+        if (header[2] != 0 || header[3] != sizeof(T)) throw std::runtime_error{"Graph file labels do not match " + path};
+
+        graph.labels = section<T>(*mapped, position, nodes);
+    }
+
+    graph.offsets = section<std::size_t>(*mapped, position, nodes + 1);
+    graph.neighbors = section<Index>(*mapped, position, edges);
+    graph.weights = section<int>(*mapped, position, edges);
+
+    /*
+     * Every algorithm indexes through these spans without checks, so a bad
+     * file is rejected here, once, in O(V + E)
+     */
+    if (graph.offsets[0] != 0 || graph.offsets[nodes] != edges)
+        throw std::runtime_error{"Corrupt graph file offsets " + path};
+    for (std::size_t i = 0; i < nodes; i++)
+        if (graph.offsets[i] > graph.offsets[i + 1])
+            throw std::runtime_error{"Corrupt graph file offsets " + path};
+    for (auto neighbor : graph.neighbors)
+        if (neighbor >= nodes)
+            throw std::runtime_error{"Corrupt graph file edges " + path};
+
+    graph.file = std::move(mapped);
+    graph.buildLookup();
+
+    return graph;
+}
+
+
+template<typename T>
+template<typename U>
+std::span<const U> CsrGraph<T>::section(const MappedFile &mapped, std::size_t &position, std::size_t count) {
+    if (position > mapped.size() || count > (mapped.size() - position) / sizeof(U))
+        throw std::runtime_error{"Truncated graph file"};
+
+    auto data = reinterpret_cast<const U *>(mapped.data() + position);
+    position += (count * sizeof(U) + 7) / 8 * 8;
+    return {data, count};
+}
+
+
+template<typename T>
+template<typename U>
+void CsrGraph<T>::writeSection(std::ofstream &out, const U *data, std::size_t count) {
+    constexpr char padding[8]{};
+
+    out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(U)));
+    out.write(padding, static_cast<std::streamsize>((8 - count * sizeof(U) % 8) % 8));
+}
+
+/*
+ * Dijkstra over the flat arrays: the state of a query is a few vectors of V
+ * entries and the search stops as soon as the target is settled.
+ */
+
+template<typename T>
+Path CsrGraph<T>::getShortestDistance(const T &from, const T &to) const {
+    auto source = indexOf(from);
+    auto target = indexOf(to);
+
+    IndexedHeap<int> heap(nodeCount());
+    std::vector<int> distances(nodeCount(), std::numeric_limits<int>::max());
+    std::vector<Index> previousNodes(nodeCount(), npos);
+    std::vector<char> visited(nodeCount(), false);
+
+    distances[source] = 0;
+    heap.insert(source, 0);
+
+    while (!heap.isEmpty()) {
+        auto current = static_cast<Index>(heap.remove());
+
+        visited[current] = true;
+        if (current == target)
+            break;
+
+        for (auto i = offsets[current]; i < offsets[current + 1]; i++) {
+            auto neighbor = neighbors[i];
+            auto distance = distances[current] + weights[i];
+            if (!visited[neighbor] && distance < distances[neighbor]) {
+                distances[neighbor] = distance;
+                previousNodes[neighbor] = current;
+                heap.update(neighbor, distance);
+            }
+        }
+    }
+
+    return buildPath(target, previousNodes);
+}
+
+
+template<typename T>
+Path CsrGraph<T>::buildPath(Index to, const std::vector<Index> &previousNodes) const {
+    std::vector<Index> stack;
+    for (auto current = to; current != npos; current = previousNodes[current])
+        stack.push_back(current);
+
+    Path path;
+    while (!stack.empty()) {
+        path.addNode(labels[stack.back()]);
+        stack.pop_back();
+    }
+    return path;
+}
+
+/*
+ * Delta-stepping (Meyer & Sanders). Distances and predecessors are packed in a
+ * single 64-bit atomic (distance in the high half), so a relaxation is one
+ * compare-and-swap and a distance never gets paired with a stale predecessor.
+ *
+ * The lowest non empty bucket is emptied by repeatedly relaxing its light edges
+ * (weight <= delta), which may refill it; then the heavy edges of every vertex
+ * removed from it are relaxed once. Each round of relaxations is split among
+ * the threads, the updated vertices are put back in their buckets afterwards.
+ */
+
+template<typename T>
+typename CsrGraph<T>::ShortestPaths CsrGraph<T>::deltaStepping(const T &from, int delta, unsigned threads) const {
+    if (delta <= 0) throw std::runtime_error{"Invalid argument"};
+
+    constexpr std::uint64_t unreached = std::numeric_limits<std::uint64_t>::max();
+    auto pack = [](std::uint64_t distance, Index previous) { return (distance << 32) | previous; };
+    auto distanceOf = [](std::uint64_t packed) { return packed >> 32; };
+
+    auto source = indexOf(from);
+    threads = std::max(threads, 1u);
+
+    std::vector<std::atomic<std::uint64_t>> state(nodeCount());
+    for (auto &entry : state)
+        entry.store(unreached, std::memory_order_relaxed);
+    state[source].store(pack(0, npos), std::memory_order_relaxed);
+
+    auto relax = [&](Index node, std::uint64_t distance, Index previous) {
+        auto candidate = pack(distance, previous);
+        auto current = state[node].load(std::memory_order_relaxed);
+        while (candidate < current)
+            if (state[node].compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+                return true;
+        return false;
+    };
+
+    std::map<std::uint64_t, std::vector<Index>> buckets;
+    std::vector<std::vector<Index>> updated(threads);
+    std::vector<unsigned> phase(nodeCount(), 0);
+    unsigned currentPhase{};
+
+    auto placeUpdated = [&]() {
+        for (auto &local : updated) {
+            for (auto node : local)
+                buckets[distanceOf(state[node].load(std::memory_order_relaxed)) / delta].push_back(node);
+            local.clear();
+        }
+    };
+
+    auto relaxEdges = [&](const std::vector<Index> &frontier, bool light) {
+        parallelFor(frontier.size(), threads, [&](std::size_t begin, std::size_t end, unsigned thread) {
+            for (auto i = begin; i < end; i++) {
+                auto node = frontier[i];
+                auto distance = distanceOf(state[node].load(std::memory_order_relaxed));
+                for (auto edge = offsets[node]; edge < offsets[node + 1]; edge++) {
+                    if ((weights[edge] <= delta) != light)
+                        continue;
+                    if (relax(neighbors[edge], distance + weights[edge], node))
+                        updated[thread].push_back(neighbors[edge]);
+                }
+            }
+        });
+    };
+
+    buckets[0].push_back(source);
+
+    while (!buckets.empty()) {
+        auto bucket = buckets.begin()->first;
+        std::vector<Index> removed;
+
+        while (!buckets.empty() && buckets.begin()->first == bucket) {
+            auto pending = std::move(buckets.begin()->second);
+            buckets.erase(buckets.begin());
+
+            /*
+             * A vertex may have been queued several times or moved to a lower
+             * bucket since: keep each vertex once, and only if it still belongs here.
+             */
+            std::vector<Index> frontier;
+            currentPhase++;
+            for (auto node : pending) {
+                if (phase[node] != currentPhase && distanceOf(state[node].load(std::memory_order_relaxed)) / delta == bucket) {
+                    phase[node] = currentPhase;
+                    frontier.push_back(node);
+                }
+            }
+
+            relaxEdges(frontier, true);
+            removed.insert(removed.end(), frontier.begin(), frontier.end());
+            placeUpdated();
+        }
+
+        std::sort(removed.begin(), removed.end());
+        removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+        relaxEdges(removed, false);
+        placeUpdated();
+    }
+
+    ShortestPaths paths;
+    paths.distances.resize(nodeCount());
+    paths.previousNodes.resize(nodeCount());
+    for (Index node = 0; node < nodeCount(); node++) {
+        auto packed = state[node].load(std::memory_order_relaxed);
+        paths.distances[node] = packed == unreached ? std::numeric_limits<int>::max() : static_cast<int>(distanceOf(packed));
+        paths.previousNodes[node] = packed == unreached ? npos : static_cast<Index>(packed);
+    }
+    return paths;
+}
+
+/*
+ * state: 0 = not visited, 1 = visiting (on the stack), 2 = visited
+ */
+
+template<typename T>
+bool CsrGraph<T>::hasCycle() const {
+    std::vector<char> state(nodeCount(), 0);
+
+    for (Index i = 0; i < nodeCount(); i++)
+        if (!state[i] && hasCycle(i, state))
+            return true;
+
+    return false;
+}
+
+/*
+ * Iterative DFS (no recursion, so deep graphs do not overflow the stack).
+ * In an undirected graph the edge leading back to the parent is skipped once,
+ * any other edge to an already visited vertex closes a cycle.
+ */
+
+template<typename T>
+bool CsrGraph<T>::hasCycle(Index root, std::vector<char> &state) const {
+    struct Frame {
+        Index node;
+        Index parent;
+        std::size_t next;
+        bool skippedParent;
+    };
+
+    std::vector<Frame> stack;
+    stack.push_back({root, npos, offsets[root], false});
+    state[root] = 1;
+
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+
+        if (frame.next == offsets[frame.node + 1]) {
+            state[frame.node] = 2;
+            stack.pop_back();
+            continue;
+        }
+
+        auto current = frame.node;
+        auto neighbor = neighbors[frame.next++];
+
+        if (directed) {
+            if (state[neighbor] == 1)
+                return true;
+        } else {
+            if (neighbor == frame.parent && !frame.skippedParent) {
+                frame.skippedParent = true;
+                continue;
+            }
+            if (state[neighbor])
+                return true;
+        }
+
+        if (!state[neighbor]) {
+            state[neighbor] = 1;
+            stack.push_back({neighbor, current, offsets[neighbor], false});
+        }
+    }
+
+    return false;
+}
+
+
+template<typename T>
+std::vector<T> CsrGraph<T>::DFS(const T &root) const {
+    std::vector<T> order;
+    std::vector<char> visited(nodeCount(), false);
+    std::vector<Index> stack;
+
+    stack.push_back(indexOf(root));
+    while (!stack.empty()) {
+        auto current = stack.back();
+        stack.pop_back();
+
+        if (visited[current])
+            continue;
+
+        visited[current] = true;
+        order.push_back(labels[current]);
+
+        for (auto i = offsets[current]; i < offsets[current + 1]; i++)
+            if (!visited[neighbors[i]])
+                stack.push_back(neighbors[i]);
+    }
+
+    return order;
+}
+
+
+template<typename T>
+std::vector<T> CsrGraph<T>::BFS(const T &root) const {
+    std::vector<T> order;
+    std::vector<char> visited(nodeCount(), false);
+    std::vector<Index> queue;
+
+    auto source = indexOf(root);
+    visited[source] = true;
+    queue.push_back(source);
+
+    /*
+     * The vector is used as a queue: every vertex is pushed once, so `head`
+     * walks it front to back without popping.
+     */
+    for (std::size_t head = 0; head < queue.size(); head++) {
+        auto current = queue[head];
+        order.push_back(labels[current]);
+
+        for (auto i = offsets[current]; i < offsets[current + 1]; i++) {
+            if (!visited[neighbors[i]]) {
+                visited[neighbors[i]] = true;
+                queue.push_back(neighbors[i]);
+            }
+        }
+    }
+
+    return order;
+}
+
+
+template<typename T>
+typename CsrGraph<T>::BreadthFirstTree CsrGraph<T>::breadthFirstSearch(const T &root, unsigned threads) const {
+    if (!directed)
+        return breadthFirstSearch(root, *this, threads);
+
+    return breadthFirstSearch(root, transpose(), threads);
+}
+
+/*
+ * Direction optimizing BFS (Beamer, Asanovic & Patterson).
+ *
+ * Top-down step: every frontier vertex claims its unvisited neighbors (one
+ * atomic fetch_or on the visited bitmap decides the owner), good while the
+ * frontier is small.
+ * Bottom-up step: every unvisited vertex looks for a parent among its incoming
+ * edges and stops at the first one found in the frontier bitmap, far fewer
+ * edge checks once the frontier holds a big part of the graph.
+ *
+ * The search switches to bottom-up when the frontier's edges outnumber
+ * unexplored edges / alpha and back when the frontier shrinks under V / beta.
+ */
+
+template<typename T>
+typename CsrGraph<T>::BreadthFirstTree
+CsrGraph<T>::breadthFirstSearch(const T &root, const CsrGraph<T> &reverse, unsigned threads) const {
+    constexpr std::size_t alpha = 14;
+    constexpr std::size_t beta = 24;
+    using Bitmap = std::vector<std::atomic<std::uint64_t>>;
+
+    auto source = indexOf(root);
+    auto words = (nodeCount() + 63) / 64;
+    auto bit = [](Index node) { return std::uint64_t{1} << (node % 64); };
+    threads = std::max(threads, 1u);
+
+    BreadthFirstTree tree{std::vector<int>(nodeCount(), -1), std::vector<Index>(nodeCount(), npos), 0};
+    Bitmap visited(words);
+    Bitmap frontierBits(words);
+    Bitmap nextBits(words);
+    std::vector<Index> frontier{source};
+    std::vector<std::vector<Index>> discovered(threads);
+    std::vector<std::size_t> scanned(threads, 0);
+
+    visited[source / 64].store(bit(source));
+    tree.levels[source] = 0;
+
+    auto topDownStep = [&](int level) {
+        parallelFor(frontier.size(), threads, [&](std::size_t begin, std::size_t end, unsigned thread) {
+            for (auto i = begin; i < end; i++) {
+                auto node = frontier[i];
+                for (auto edge = offsets[node]; edge < offsets[node + 1]; edge++) {
+                    auto neighbor = neighbors[edge];
+                    scanned[thread]++;
+                    if (visited[neighbor / 64].load(std::memory_order_relaxed) & bit(neighbor))
+                        continue;
+                    if (visited[neighbor / 64].fetch_or(bit(neighbor), std::memory_order_relaxed) & bit(neighbor))
+                        continue;
+                    tree.parents[neighbor] = node;
+                    tree.levels[neighbor] = level;
+                    discovered[thread].push_back(neighbor);
+                }
+            }
+        });
+
+        frontier.clear();
+        for (auto &local : discovered) {
+            frontier.insert(frontier.end(), local.begin(), local.end());
+            local.clear();
+        }
+        return frontier.size();
+    };
+
+    auto bottomUpStep = [&](int level) {
+        std::vector<std::size_t> found(threads, 0);
+        for (auto &word : nextBits)
+            word.store(0, std::memory_order_relaxed);
+
+        parallelFor(nodeCount(), threads, [&](std::size_t begin, std::size_t end, unsigned thread) {
+            for (auto node = static_cast<Index>(begin); node < end; node++) {
+                if (visited[node / 64].load(std::memory_order_relaxed) & bit(node))
+                    continue;
+                for (auto edge = reverse.offsets[node]; edge < reverse.offsets[node + 1]; edge++) {
+                    auto parent = reverse.neighbors[edge];
+                    scanned[thread]++;
+                    if (frontierBits[parent / 64].load(std::memory_order_relaxed) & bit(parent)) {
+                        tree.parents[node] = parent;
+                        tree.levels[node] = level;
+                        visited[node / 64].fetch_or(bit(node), std::memory_order_relaxed);
+                        nextBits[node / 64].fetch_or(bit(node), std::memory_order_relaxed);
+                        found[thread]++;
+                        break;
+                    }
+                }
+            }
+        });
+
+        std::swap(frontierBits, nextBits);
+        std::size_t total{};
+        for (auto count : found)
+            total += count;
+        return total;
+    };
+
+    auto listToBitmap = [&]() {
+        for (auto &word : frontierBits)
+            word.store(0, std::memory_order_relaxed);
+        for (auto node : frontier)
+            frontierBits[node / 64].fetch_or(bit(node), std::memory_order_relaxed);
+    };
+
+    auto bitmapToList = [&]() {
+        frontier.clear();
+        for (Index node = 0; node < nodeCount(); node++)
+            if (frontierBits[node / 64].load(std::memory_order_relaxed) & bit(node))
+                frontier.push_back(node);
+    };
+
+    bool bottomUp = false;
+    std::size_t frontierSize = 1;
+    std::size_t previousSize = 0;
+    std::size_t unexplored = edgeCount();
+
+    for (int level = 1; frontierSize > 0; level++) {
+        if (!bottomUp) {
+            std::size_t frontierEdges{};
+            for (auto node : frontier)
+                frontierEdges += offsets[node + 1] - offsets[node];
+            unexplored -= std::min(unexplored, frontierEdges);
+
+            if (frontierEdges > unexplored / alpha) {
+                listToBitmap();
+                bottomUp = true;
+            }
+        } else if (frontierSize < nodeCount() / beta && frontierSize < previousSize) {
+            bitmapToList();
+            bottomUp = false;
+        }
+
+        previousSize = frontierSize;
+        frontierSize = bottomUp ? bottomUpStep(level) : topDownStep(level);
+    }
+
+    for (auto count : scanned)
+        tree.traversedEdges += count;
+    return tree;
+}
+
+/*
+ * Counting sort of the edges by target vertex.
+ */
+
+template<typename T>
+CsrGraph<T> CsrGraph<T>::transpose() const {
+    std::vector<std::size_t> reverseOffsets(nodeCount() + 1, 0);
+    std::vector<Index> reverseNeighbors(edgeCount());
+    std::vector<int> reverseWeights(edgeCount());
+
+    for (auto neighbor : neighbors)
+        reverseOffsets[neighbor + 1]++;
+    for (std::size_t node = 0; node < nodeCount(); node++)
+        reverseOffsets[node + 1] += reverseOffsets[node];
+
+    std::vector<std::size_t> next(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (Index node = 0; node < nodeCount(); node++) {
+        for (auto edge = offsets[node]; edge < offsets[node + 1]; edge++) {
+            auto position = next[neighbors[edge]]++;
+            reverseNeighbors[position] = node;
+            reverseWeights[position] = weights[edge];
+        }
+    }
+
+    return CsrGraph<T>{std::vector<T>(labels.begin(), labels.end()), std::move(reverseOffsets),
+                       std::move(reverseNeighbors), std::move(reverseWeights), directed};
+}
+
+
+template<typename T>
+std::vector<typename CsrGraph<T>::Index> CsrGraph<T>::reverseCuthillMcKee() const {
+    auto degree = [this](Index node) { return offsets[node + 1] - offsets[node]; };
+    auto byDegree = [&degree](Index lhs, Index rhs) { return degree(lhs) < degree(rhs); };
+
+    std::vector<Index> starts(nodeCount());
+    for (Index node = 0; node < nodeCount(); node++)
+        starts[node] = node;
+    std::stable_sort(starts.begin(), starts.end(), byDegree);
+
+    std::vector<Index> order;
+    std::vector<Index> discovered;
+    std::vector<char> visited(nodeCount(), false);
+    order.reserve(nodeCount());
+
+    for (auto start : starts) {
+        if (visited[start])
+            continue;
+
+        visited[start] = true;
+        order.push_back(start);
+
+        for (auto head = order.size() - 1; head < order.size(); head++) {
+            auto node = order[head];
+            discovered.clear();
+            for (auto edge = offsets[node]; edge < offsets[node + 1]; edge++) {
+                if (!visited[neighbors[edge]]) {
+                    visited[neighbors[edge]] = true;
+                    discovered.push_back(neighbors[edge]);
+                }
+            }
+            std::stable_sort(discovered.begin(), discovered.end(), byDegree);
+            order.insert(order.end(), discovered.begin(), discovered.end());
+        }
+    }
+
+    std::vector<Index> newIds(nodeCount());
+    for (std::size_t i = 0; i < order.size(); i++)
+        newIds[order[i]] = static_cast<Index>(order.size() - 1 - i);
+    return newIds;
+}
+
+
+template<typename T>
+std::vector<typename CsrGraph<T>::Index> CsrGraph<T>::degreeOrder() const {
+    std::vector<Index> order(nodeCount());
+    for (Index node = 0; node < nodeCount(); node++)
+        order[node] = node;
+    std::stable_sort(order.begin(), order.end(), [this](Index lhs, Index rhs) {
+        return offsets[lhs + 1] - offsets[lhs] > offsets[rhs + 1] - offsets[rhs];
+    });
+
+    std::vector<Index> newIds(nodeCount());
+    for (std::size_t i = 0; i < order.size(); i++)
+        newIds[order[i]] = static_cast<Index>(i);
+    return newIds;
+}
+
+
+template<typename T>
+CsrGraph<T> CsrGraph<T>::permute(const std::vector<Index> &newIds) const {
+    if (newIds.size() != nodeCount())
+        throw std::runtime_error{"Invalid argument"};
+
+    std::vector<Index> oldIds(nodeCount(), npos);
+    for (Index node = 0; node < nodeCount(); node++) {
+        if (newIds[node] >= nodeCount() || oldIds[newIds[node]] != npos)
+            throw std::runtime_error{"Not a permutation"};
+        oldIds[newIds[node]] = node;
+    }
+
+    std::vector<T> permutedLabels;
+    std::vector<std::size_t> permutedOffsets{0};
+    std::vector<Index> permutedNeighbors;
+    std::vector<int> permutedWeights;
+    std::vector<std::pair<Index, int>> edges;
+
+    permutedLabels.reserve(nodeCount());
+    permutedOffsets.reserve(nodeCount() + 1);
+    permutedNeighbors.reserve(edgeCount());
+    permutedWeights.reserve(edgeCount());
+
+    for (auto old : oldIds) {
+        permutedLabels.push_back(labels[old]);
+
+        edges.clear();
+        for (auto edge = offsets[old]; edge < offsets[old + 1]; edge++)
+            edges.emplace_back(newIds[neighbors[edge]], weights[edge]);
+        std::sort(edges.begin(), edges.end());
+
+        for (auto &edge : edges) {
+            permutedNeighbors.push_back(edge.first);
+            permutedWeights.push_back(edge.second);
+        }
+        permutedOffsets.push_back(permutedNeighbors.size());
+    }
+
+    return CsrGraph<T>{std::move(permutedLabels), std::move(permutedOffsets), std::move(permutedNeighbors),
+                       std::move(permutedWeights), directed};
+}
+
+
+template<typename T>
+void CsrGraph<T>::print() const {
+    for (Index node = 0; node < nodeCount(); node++) {
+        std::cout << labels[node] << " is connected to [ ";
+        for (auto i = offsets[node]; i < offsets[node + 1]; i++)
+            std::cout << labels[node] << "->" << labels[neighbors[i]] << " ";
+        std::cout << "]\n";
+    }
+}
+
+#endif //DATA__STRUCTURES_CSRGRAPH_CPP
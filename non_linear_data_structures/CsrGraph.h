@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Compressed Sparse Row Graph (frozen snapshot of a graph)
+ *
+ * -> CSR Applications:
+ *  1. Read-only queries on large graphs (road networks, GPS)
+ *  2. Sparse matrix computations
+ *
+ * -> Layout, being V the number of vertices and E the number of edges:
+ *      - labels     [V]      label of every vertex id (sorted, unless the ids
+ *                            were renumbered, see permute)
+ *      - offsets    [V + 1]  edges of vertex i are [offsets[i], offsets[i + 1])
+ *      - neighbors  [E]      target vertex id of every edge
+ *      - weights    [E]      weight of every edge
+ *
+ *  Every array is contiguous, so walking the edges of a vertex is a linear
+ *  scan instead of chasing Node -> Edge* -> Node* pointers.
+ *
+ *      Case             Adjacency List  |     CSR
+ *      ---------------------------------------------------
+ *      Space            O(V+E)          |     O(V+E)
+ *      Add edge         O(K)            |     not supported (frozen)
+ *      Find neighbors   O(K)            |     O(K) contiguous
+ *      Look up label    O(log V)        |     O(log V)
+ *
+ * -> On disk (save / open), native byte order, every section 8-byte aligned:
+ *      header   "CSRG" | uint32 version | uint32 directed | uint32 label kind
+ *               | uint32 label size | uint32 reserved | uint64 V | uint64 E
+ *               | uint64 label bytes
+ *      labels   V raw labels (trivially copyable T) or, for std::string,
+ *               uint64 offsets[V + 1] followed by the characters
+ *      offsets  uint64[V + 1]
+ *      edges    uint32 neighbors[E], then int32 weights[E]
+ *  open() maps the file and points the graph straight into it: nothing is
+ *  parsed or copied (only std::string labels are rebuilt, O(V)); the sizes,
+ *  offsets and edges are checked once, O(V + E), and a corrupt file throws.
+ *
+ * https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_CSRGRAPH_H
+#define DATA__STRUCTURES_CSRGRAPH_H
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <span>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <type_traits>
+
+#include "Path.cpp"
+#include "IndexedHeap.h"
+#include "IndexedHeap.cpp"
+#include "MappedFile.cpp"
+#include "Parallel.h"
+#include "Parallel.cpp"
+
+template<typename T>
+class CsrGraph {
+
+public:
+
+    using VT = T;
+    using Index = std::uint32_t;
+
+    static constexpr Index npos = std::numeric_limits<Index>::max();
+
+    /*
+     * Result of a one-to-all search, indexed by vertex id: distances[i] is
+     * std::numeric_limits<int>::max() and previousNodes[i] is npos when i is unreachable
+     */
+    struct ShortestPaths {
+        std::vector<int> distances;
+        std::vector<Index> previousNodes;
+    };
+
+    /*
+     * Result of a breadth first search, indexed by vertex id: levels[i] is the
+     * number of edges from the root (-1 if unreachable), parents[i] the vertex
+     * it was discovered from (npos for the root and unreachable vertices).
+     * traversedEdges counts the edges examined, for TEPS measurements.
+     */
+    struct BreadthFirstTree {
+        std::vector<int> levels;
+        std::vector<Index> parents;
+        std::size_t traversedEdges;
+    };
+
+public:
+
+    /*
+     * labels must be unique, offsets must hold labels.size() + 1 entries.
+     * Sorted labels are searched in place, otherwise a sorted copy of the ids
+     * is kept for indexOf (O(V log V) to build, V more ids in memory).
+     */
+    CsrGraph(std::vector<T> labels, std::vector<std::size_t> offsets,
+             std::vector<Index> neighbors, std::vector<int> weights, bool directed);
+
+    CsrGraph(const CsrGraph &other);
+
+    CsrGraph(CsrGraph &&other) noexcept = default;
+
+    CsrGraph &operator=(const CsrGraph &other);
+
+    CsrGraph &operator=(CsrGraph &&other) noexcept = default;
+
+public:
+
+    static constexpr std::uint32_t version = 1;
+
+    void save(const std::string &path) const;
+
+    static CsrGraph<T> open(const std::string &path);
+
+public:
+
+    [[nodiscard]] std::size_t nodeCount() const;
+
+    [[nodiscard]] std::size_t edgeCount() const;
+
+    [[nodiscard]] bool isDirected() const;
+
+    Index indexOf(const T &label) const;
+
+    const T &label(Index index) const;
+
+    /*
+     * Raw access to the edges: the edges of `node` are [firstEdge(node), lastEdge(node))
+     */
+    [[nodiscard]] std::size_t firstEdge(Index node) const;
+
+    [[nodiscard]] std::size_t lastEdge(Index node) const;
+
+    [[nodiscard]] Index target(std::size_t edge) const;
+
+    [[nodiscard]] int weight(std::size_t edge) const;
+
+    Path getShortestDistance(const T &from, const T &to) const;
+
+    /*
+     * Parallel delta-stepping (non negative weights): vertices are grouped in
+     * buckets of width delta, the edges of a bucket are relaxed by `threads` workers
+     */
+    ShortestPaths deltaStepping(const T &from, int delta,
+                                unsigned threads = std::thread::hardware_concurrency()) const;
+
+    bool hasCycle() const;
+
+    std::vector<T> DFS(const T &root) const;
+
+    std::vector<T> BFS(const T &root) const;
+
+    /*
+     * Direction optimizing parallel BFS. The bottom-up steps walk the incoming
+     * edges, taken from `reverse` (the transpose, see transpose()); the first
+     * overload uses the graph itself when undirected and builds the transpose otherwise.
+     */
+    BreadthFirstTree breadthFirstSearch(const T &root, unsigned threads = std::thread::hardware_concurrency()) const;
+
+    BreadthFirstTree breadthFirstSearch(const T &root, const CsrGraph<T> &reverse,
+                                        unsigned threads = std::thread::hardware_concurrency()) const;
+
+    /*
+     * Same vertex ids, every edge reversed
+     */
+    CsrGraph<T> transpose() const;
+
+    /*
+     * Vertex orderings for locality, newIds[old id] = new id, applied with permute():
+     *  - reverse Cuthill-McKee: BFS from a lowest degree vertex of every
+     *    component taking neighbors by increasing degree, then reversed; the
+     *    ends of an edge get close ids, so traversals stay in nearby memory
+     *  - degree: highest degree first, the hubs share a few cache lines
+     */
+    std::vector<Index> reverseCuthillMcKee() const;
+
+    std::vector<Index> degreeOrder() const;
+
+    /*
+     * Copy of the graph where vertex i becomes newIds[i] (a permutation of the
+     * ids), the edges of every vertex sorted by target. Labels keep working
+     * with indexOf.
+     */
+    CsrGraph<T> permute(const std::vector<Index> &newIds) const;
+
+    void print() const;
+
+private:
+
+    /*
+     * The algorithms only read the spans. They point either into the owned
+     * vectors below or into a mapped file kept alive by `file`.
+     */
+    std::span<const T> labels;
+    std::span<const std::size_t> offsets;
+    std::span<const Index> neighbors;
+    std::span<const int> weights;
+    bool directed;
+
+    std::vector<T> labelStorage;
+    std::vector<std::size_t> offsetStorage;
+    std::vector<Index> neighborStorage;
+    std::vector<int> weightStorage;
+    std::shared_ptr<const MappedFile> file;
+    std::vector<Index> lookup;
+
+private:
+
+    CsrGraph();
+
+    void buildLookup();
+
+    template<typename U>
+    static std::span<const U> rebind(std::span<const U> view, const std::vector<U> &from, const std::vector<U> &to);
+
+    template<typename U>
+    static std::span<const U> section(const MappedFile &mapped, std::size_t &position, std::size_t count);
+
+    template<typename U>
+    static void writeSection(std::ofstream &out, const U *data, std::size_t count);
+
+    Path buildPath(Index to, const std::vector<Index> &previousNodes) const;
+
+    bool hasCycle(Index root, std::vector<char> &state) const;
+};
+
+
+#endif //DATA__STRUCTURES_CSRGRAPH_H
@@ -13,9 +13,9 @@ template<typename GRAPH>
 Edge<GRAPH>::Edge() = default;
 
 
+/*
+ * An edge does not own its nodes: they belong to the graph (and its arena).
+ */
 template<typename GRAPH>
-Edge<GRAPH>::~Edge()  {
-    delete from;
-    delete to;
-}
+Edge<GRAPH>::~Edge() = default;
 
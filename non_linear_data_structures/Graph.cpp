@@ -43,28 +43,65 @@
 #include "Graph.h"
 
 template <typename T>
-Graph<T>::Graph() : mCounter{}
+Graph<T>::Graph() : acyclic{false}, nextOrder{}, markEpoch{}
 {
-    adjacencyList = new std::map<Node*, std::list<Node *> *>{};
     vertices = new std::map<T, Node *>{};
 }
 
 template <typename T>
 Graph<T>::~Graph()
 {
+    if (vertices == nullptr)
+        return;
+
+    for (auto &pair : *vertices)
+        delete pair.second;
     delete vertices;
-    delete adjacencyList;
 }
 
+template <typename T>
+Graph<T>::Graph(Graph &&other) noexcept
+    : vertices{std::exchange(other.vertices, nullptr)},
+      nodes{std::move(other.nodes)},
+      freeIndices{std::move(other.freeIndices)},
+      adjacency{std::move(other.adjacency)},
+      acyclic{other.acyclic},
+      order{std::move(other.order)},
+      nextOrder{other.nextOrder},
+      markEpoch{}
+{
+}
+
+/*
+ * The node refers to the key stored in the map, not to the caller's argument.
+ */
 template <typename T>
 void Graph<T>::addNode(const T &label)
 {
+    auto pair = vertices->insert({label, nullptr});
+    if (!pair.second)
+        return;
+
+    std::size_t index = nodes.size();
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        nodes.push_back(nullptr);
+        order.push_back(0);
+    }
 
-    auto node = new Node{label};
-    vertices->insert({label, node});
-    adjacencyList->insert({node, new std::list<Node *>{}});
+    auto node = new Node{pair.first->first, index};
+    pair.first->second = node;
+    nodes[index] = node;
+    order[index] = nextOrder++;
+    adjacency.addVertex(static_cast<Id>(index));
 }
 
+/*
+ * Adding an edge that already exists does nothing. In acyclic mode the order is
+ * repaired first, which fails if `to` reaches `from`.
+ */
 template <typename T>
 void Graph<T>::addEdge(const T &from, const T &to)
 {
@@ -74,15 +111,37 @@ void Graph<T>::addEdge(const T &from, const T &to)
     if (fromNode == vertices->end() || toNode == vertices->end())
         throw std::runtime_error{"No such elements"};
 
-    adjacencyList->lower_bound(fromNode->second)->second->push_back(toNode->second);
+    auto fromId = idOf(fromNode->second);
+    auto toId = idOf(toNode->second);
+
+    if (acyclic && !adjacency.hasEdge(fromId, toId) && !reorder(fromId, toId))
+        throw std::runtime_error{"Edge would create a cycle"};
+
+    adjacency.addEdge(fromId, toId);
+}
+
+template <typename T>
+bool Graph<T>::hasEdge(const T &from, const T &to)
+{
+    auto fromNode = getNode(from);
+    auto toNode = getNode(to);
+
+    if (fromNode == vertices->end() || toNode == vertices->end())
+        return false;
+
+    return adjacency.hasEdge(idOf(fromNode->second), idOf(toNode->second));
 }
 
 template <typename T>
 bool Graph<T>::isEmpty() const
 {
-    return !mCounter;
+    return vertices->empty();
 }
 
+/*
+ * Only the edges of the node are visited (its predecessors are known), the
+ * index of the node goes back to the free list.
+ */
 template <typename T>
 void Graph<T>::removeNode(const T &label)
 {
@@ -91,11 +150,13 @@ void Graph<T>::removeNode(const T &label)
     if (node == vertices->end())
         throw std::runtime_error{"No such element to be removed"};
 
-    for (auto itr = adjacencyList->begin(); itr != adjacencyList->end(); itr++)
-        adjacencyList->lower_bound(itr->first)->second->remove(node->second);
+    auto removed = node->second;
+    adjacency.removeVertex(idOf(removed));
+    nodes[removed->index] = nullptr;
+    freeIndices.push_back(removed->index);
 
-    vertices->erase(label);
-    adjacencyList->erase(node->second);
+    vertices->erase(node);
+    delete removed;
 }
 
 template <typename T>
@@ -108,19 +169,20 @@ void Graph<T>::removeEdge(const T &from, const T &to)
     if (fromNode == vertices->end() || toNode == vertices->end())
         throw std::runtime_error{"No such elements"};
 
-    adjacencyList->at(fromNode->second)->remove(toNode->second);
+    adjacency.removeEdge(idOf(fromNode->second), idOf(toNode->second));
 }
 
 template <typename T>
 void Graph<T>::print() const
 {
-    for (auto itr = adjacencyList->begin(); itr != adjacencyList->end(); itr++)
+    for (auto &pair : *vertices)
     {
-        if (itr->second->empty())
+        auto &successors = adjacency.successors(idOf(pair.second));
+        if (successors.empty())
             continue;
-        std::cout << itr->first->label << " is connected to [ ";
-        for (auto &values : *itr->second)
-            std::cout << values->label << " ";
+        std::cout << pair.first << " is connected to [ ";
+        for (auto id : successors)
+            std::cout << nodes[id]->label << " ";
         std::cout << "]\n";
     }
 }
@@ -128,154 +190,465 @@ void Graph<T>::print() const
 template <typename T>
 typename Graph<T>::iterator Graph<T>::getNode(const T &value)
 {
-    return vertices->lower_bound(value);
+    return vertices->find(value);
 }
 
 template <typename T>
-void Graph<T>::DFSRec(const T &root)
+typename Graph<T>::Node *Graph<T>::findNode(const T &label)
 {
-    auto pair = getNode(root);
+    auto pair = vertices->find(label);
 
     if (pair == vertices->end())
         throw std::runtime_error{"Invalid argument"};
 
-    std::set<Node *> visited;
-    DFSRec(pair->second, visited);
+    return pair->second;
 }
 
+/*
+ * Indices of removed nodes are reused, so the bitmap never outgrows the
+ * largest number of nodes the graph has held.
+ */
 template <typename T>
-void Graph<T>::DFSRec(Node *root, std::set<Node *> visited)
+void Graph<T>::resetVisited()
 {
+    visited.assign((nodes.size() + 63) / 64, 0);
+}
 
-    std::cout << root->label << std::endl;
+template <typename T>
+typename Graph<T>::Id Graph<T>::idOf(const Node *node)
+{
+    return static_cast<Id>(node->index);
+}
 
-    visited.insert(root);
+template <typename T>
+bool Graph<T>::markVisited(const Node *node)
+{
+    auto bit = std::uint64_t{1} << (node->index % 64);
+    if (visited[node->index / 64] & bit)
+        return false;
 
-    for (auto &item : *adjacencyList->at(root))
-    {
-        if (!visited.count(item))
-            DFSRec(item, visited);
-        break;
-    }
+    visited[node->index / 64] |= bit;
+    return true;
+}
+
+template <typename T>
+void Graph<T>::DFSRec(const T &root)
+{
+    LabelPrinter printer;
+    depthFirst(root, printer);
 }
 
 template <typename T>
 void Graph<T>::DFSIter(const T &root)
 {
-    auto pair = getNode(root);
+    LabelPrinter printer;
+    depthFirst(root, printer);
+}
 
-    if (pair == vertices->end())
-        throw std::runtime_error{"Invalid argument"};
+template <typename T>
+void Graph<T>::BFS(const T &root)
+{
+    LabelPrinter printer;
+    breadthFirst(root, printer);
+}
 
-    std::stack<Node *> stack;
-    std::set<Node *> visited;
+/*
+ * Every stack frame keeps the position of the next edge to examine, so a node
+ * is finished only once all its descendants are, like in the recursive version.
+ */
+template <typename T>
+template <typename Visitor>
+void Graph<T>::depthFirst(const T &root, Visitor &visitor)
+{
+    auto start = findNode(root);
 
-    stack.push(pair->second);
-    while (!stack.empty())
-    {
+    resetVisited();
+    traversalStack.clear();
 
-        auto current = stack.top();
-        stack.pop();
+    markVisited(start);
+    visitor.discover(start->label);
+    traversalStack.push_back({start, 0});
+
+    while (!traversalStack.empty())
+    {
+        auto &frame = traversalStack.back();
+        auto node = frame.first;
+        auto &successors = adjacency.successors(idOf(node));
 
-        if (visited.count(current))
+        if (frame.second == successors.size())
+        {
+            visitor.finish(node->label);
+            traversalStack.pop_back();
             continue;
+        }
 
-        std::cout << current->label << std::endl;
-        visited.insert(current);
+        auto neighbor = nodes[successors[frame.second++]];
+        visitor.examineEdge(node->label, neighbor->label);
 
-        for (auto &neighbor : *adjacencyList->at(current))
+        if (markVisited(neighbor))
         {
-            if (!visited.count(neighbor))
-                stack.push(neighbor);
+            visitor.discover(neighbor->label);
+            traversalStack.push_back({neighbor, 0});
         }
     }
 }
 
+/*
+ * Nodes are marked when they are queued, so each one enters the queue once and
+ * the queue is a plain vector read from the front.
+ */
 template <typename T>
-void Graph<T>::BFS(const T &root)
+template <typename Visitor>
+void Graph<T>::breadthFirst(const T &root, Visitor &visitor)
 {
-    auto pair = getNode(root);
+    auto start = findNode(root);
 
-    if (pair == vertices->end())
-        throw std::runtime_error{"Invalid argument"};
-
-    std::queue<Node *> queue;
-    std::set<Node *> visited;
+    resetVisited();
+    traversalQueue.clear();
 
-    queue.push(pair->second);
+    markVisited(start);
+    visitor.discover(start->label);
+    traversalQueue.push_back(start);
 
-    while (!queue.empty())
+    for (std::size_t head = 0; head < traversalQueue.size(); head++)
     {
-        auto current = queue.front();
-        queue.pop();
-
-        if (visited.count(current))
-            continue;
-
-        visited.insert(current);
-        std::cout << current->label << std::endl;
+        auto current = traversalQueue[head];
 
-        for (auto &neighbors : *adjacencyList->at(current))
+        for (auto id : adjacency.successors(idOf(current)))
         {
-            if (!visited.count(neighbors))
-                queue.push(neighbors);
+            auto neighbor = nodes[id];
+            visitor.examineEdge(current->label, neighbor->label);
+            if (markVisited(neighbor))
+            {
+                visitor.discover(neighbor->label);
+                traversalQueue.push_back(neighbor);
+            }
         }
+
+        visitor.finish(current->label);
     }
 }
 
 template<typename T>
 std::vector<T> Graph<T>::topologicalSort() {
-    std::stack<Node*> stack;
-    std::vector<T> vector;
-    std::set<Node*> visited;
+    std::vector<T> order;
+
+    for (auto &level : topologicalLevels(1))
+        for (auto &label : level)
+            order.push_back(label);
+
+    return order;
+}
 
-    for (auto & pair : *vertices) {
-        if (!visited.count(pair.second))
-            topologicalSort(pair.second, stack, visited);
+/*
+ * Kahn's algorithm one level at a time. Level 0 holds the nodes without
+ * predecessors; the nodes of a level are split between the threads, which
+ * decrement the in-degree of every successor, and whoever brings an in-degree
+ * down to 0 puts that successor in the next level. Nodes left with a non zero
+ * in-degree at the end sit on (or behind) a cycle.
+ */
+template<typename T>
+std::vector<std::vector<T>> Graph<T>::topologicalLevels(unsigned threads) {
+    threads = std::max(threads, 1u);
+
+    std::vector<std::atomic<std::uint32_t>> inDegrees(nodes.size());
+    std::vector<Id> level;
+    std::vector<std::vector<Id>> next(threads);
+    std::vector<std::vector<T>> levels;
+    std::size_t sorted{};
+
+    for (auto &pair : *vertices) {
+        auto id = idOf(pair.second);
+        auto degree = adjacency.predecessors(id).size();
+        inDegrees[id].store(static_cast<std::uint32_t>(degree), std::memory_order_relaxed);
+        if (degree == 0)
+            level.push_back(id);
     }
 
-    while (!stack.empty()){
-        vector.push_back(stack.top()->label);
-        stack.pop();
+    while (!level.empty()) {
+        sorted += level.size();
+        levels.emplace_back();
+        for (auto id : level)
+            levels.back().push_back(nodes[id]->label);
+
+        parallelFor(level.size(), threads, [&](std::size_t begin, std::size_t end, unsigned thread) {
+            for (auto i = begin; i < end; i++)
+                for (auto successor : adjacency.successors(level[i]))
+                    if (inDegrees[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        next[thread].push_back(successor);
+        });
+
+        level.clear();
+        for (auto &local : next) {
+            level.insert(level.end(), local.begin(), local.end());
+            local.clear();
+        }
     }
-    return vector;
+
+    if (sorted != vertices->size())
+        throw std::runtime_error{"Graph has a cycle"};
+
+    return levels;
 }
 
+/*
+ * Iterative DFS from every node not seen yet, state: 0 = not visited,
+ * 1 = on the stack, 2 = done. An edge to a node on the stack closes a cycle.
+ */
 template<typename T>
-void Graph<T>::topologicalSort(Node* node, std::stack<Node *> &stack, std::set<Node*> &visited) {
+bool Graph<T>::hasCycle() {
+    if (acyclic)
+        return false;
 
-    visited.insert(node);
+    std::vector<char> state(nodes.size(), 0);
+
+    for (auto &pair : *vertices) {
+        if (state[pair.second->index])
+            continue;
 
-    for (auto &neighbors : *adjacencyList->at(node)) {
-        if (!visited.count(neighbors))
-            topologicalSort(neighbors, stack, visited);
+        traversalStack.clear();
+        traversalStack.push_back({pair.second, 0});
+        state[pair.second->index] = 1;
+
+        while (!traversalStack.empty()) {
+            auto &frame = traversalStack.back();
+            auto &successors = adjacency.successors(idOf(frame.first));
+
+            if (frame.second == successors.size()) {
+                state[frame.first->index] = 2;
+                traversalStack.pop_back();
+                continue;
+            }
+
+            auto next = successors[frame.second++];
+            if (state[next] == 1)
+                return true;
+            if (state[next] == 0) {
+                state[next] = 1;
+                traversalStack.push_back({nodes[next], 0});
+            }
+        }
     }
-    stack.push(node);
+
+    return false;
 }
 
 template<typename T>
-bool Graph<T>::hasCycle() {
-    std::set<Node*> all;
-    std::set<Node*> visiting;
-    std::set<Node*> visited;
+void Graph<T>::setAcyclic(bool enabled) {
+    if (enabled && !acyclic) {
+        std::size_t position{};
+        for (auto &label : topologicalSort())
+            order[vertices->at(label)->index] = position++;
+        nextOrder = position;
+    }
 
-    for (auto &pair : *vertices)
-        return hasCycle(pair.second, visiting, visited);
+    acyclic = enabled;
 }
 
 template<typename T>
-bool Graph<T>::hasCycle(Node* node, std::set<Node *> &visiting, std::set<Node *> &visited) {
+bool Graph<T>::isAcyclic() const {
+    return acyclic;
+}
 
-    if (visiting.count(node))
+/*
+ * Pearce-Kelly: the edge from -> to breaks the order only when to comes
+ * before from. Then the nodes reachable from `to` that come before `from`
+ * (forward set) must move after the nodes reaching `from` that come after
+ * `to` (backward set); finding `from` in the forward set means a cycle. The
+ * positions the two sets held are handed back to them, backward set first.
+ */
+template<typename T>
+bool Graph<T>::reorder(Id from, Id to) {
+    if (from == to)
+        return false;
+
+    auto lower = order[to];
+    auto upper = order[from];
+    if (upper < lower)
         return true;
 
-    visiting.insert(node);
+    if (marks.size() < nodes.size())
+        marks.resize(nodes.size(), 0);
+    if (++markEpoch == 0) {
+        std::fill(marks.begin(), marks.end(), 0);
+        markEpoch = 1;
+    }
+
+    forwardSet.clear();
+    backwardSet.clear();
+
+    collect(to, upper, true, forwardSet);
+    if (marks[from] == markEpoch)
+        return false;
+    collect(from, lower, false, backwardSet);
+
+    auto byOrder = [this](Id lhs, Id rhs) { return order[lhs] < order[rhs]; };
+    std::sort(forwardSet.begin(), forwardSet.end(), byOrder);
+    std::sort(backwardSet.begin(), backwardSet.end(), byOrder);
+
+    std::vector<std::size_t> positions;
+    for (auto id : backwardSet)
+        positions.push_back(order[id]);
+    for (auto id : forwardSet)
+        positions.push_back(order[id]);
+    std::sort(positions.begin(), positions.end());
+
+    std::size_t next{};
+    for (auto id : backwardSet)
+        order[id] = positions[next++];
+    for (auto id : forwardSet)
+        order[id] = positions[next++];
+
+    return true;
+}
+
+/*
+ * Marks and collects the nodes reachable from start (along successors when
+ * forward, predecessors otherwise) whose position lies strictly between the
+ * start and bound. The forward search also reaches bound itself, which is how
+ * a cycle shows up.
+ */
+template<typename T>
+void Graph<T>::collect(Id start, std::size_t bound, bool forward, std::vector<Id> &found) {
+    marks[start] = markEpoch;
+    found.push_back(start);
+
+    for (std::size_t i = 0; i < found.size(); i++) {
+        auto &edges = forward ? adjacency.successors(found[i]) : adjacency.predecessors(found[i]);
+        for (auto id : edges) {
+            if (marks[id] == markEpoch)
+                continue;
+            if (forward ? order[id] > bound : order[id] < bound)
+                continue;
+            marks[id] = markEpoch;
+            if (order[id] == bound)
+                return;
+            found.push_back(id);
+        }
+    }
+}
+
+template<typename T>
+std::size_t Graph<T>::indexOf(const T &label) {
+    return findNode(label)->index;
+}
+
+/*
+ * Tarjan's algorithm with an explicit stack: each frame keeps the position of
+ * the next successor, and a finished node hands its low link to its parent
+ * frame. A node whose low link is its own discovery number is the root of a
+ * component, made of the nodes above it on the component stack.
+ */
+template<typename T>
+std::size_t Graph<T>::stronglyConnectedComponents(std::vector<std::size_t> &components) {
+    constexpr Id undiscovered = std::numeric_limits<Id>::max();
+
+    std::vector<Id> discovery(nodes.size(), undiscovered);
+    std::vector<Id> lowLink(nodes.size(), 0);
+    std::vector<char> onStack(nodes.size(), 0);
+    std::vector<Id> pending;
+    Id counter{};
+    std::size_t count{};
+
+    components.assign(nodes.size(), npos);
+
+    auto discover = [&](Id id) {
+        discovery[id] = lowLink[id] = counter++;
+        pending.push_back(id);
+        onStack[id] = 1;
+        traversalStack.push_back({nodes[id], 0});
+    };
+
+    for (auto &pair : *vertices) {
+        if (discovery[idOf(pair.second)] != undiscovered)
+            continue;
+
+        traversalStack.clear();
+        discover(idOf(pair.second));
+
+        while (!traversalStack.empty()) {
+            auto &frame = traversalStack.back();
+            auto node = idOf(frame.first);
+            auto &successors = adjacency.successors(node);
+
+            if (frame.second < successors.size()) {
+                auto next = successors[frame.second++];
+                if (discovery[next] == undiscovered)
+                    discover(next);
+                else if (onStack[next])
+                    lowLink[node] = std::min(lowLink[node], discovery[next]);
+                continue;
+            }
+
+            traversalStack.pop_back();
+            if (!traversalStack.empty()) {
+                auto parent = idOf(traversalStack.back().first);
+                lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+            }
+
+            if (lowLink[node] == discovery[node]) {
+                Id member;
+                do {
+                    member = pending.back();
+                    pending.pop_back();
+                    onStack[member] = 0;
+                    components[member] = count;
+                } while (member != node);
+                count++;
+            }
+        }
+    }
+
+    // Tarjan finishes the components sinks first
+    for (auto &component : components)
+        if (component != npos)
+            component = count - 1 - component;
+
+    return count;
+}
+
+template<typename T>
+Graph<std::size_t> Graph<T>::condense() {
+    std::vector<std::size_t> components;
+    auto count = stronglyConnectedComponents(components);
+
+    Graph<std::size_t> dag;
+    for (std::size_t component = 0; component < count; component++)
+        dag.addNode(component);
+
+    for (auto &pair : *vertices) {
+        auto from = components[pair.second->index];
+        for (auto id : adjacency.successors(idOf(pair.second)))
+            if (components[id] != from)
+                dag.addEdge(from, components[id]);
+    }
+
+    return dag;
+}
+
+/*
+ * Vertex ids follow the (sorted) order of the vertices map.
+ */
+template<typename T>
+CsrGraph<T> Graph<T>::freeze() const {
+    using Index = typename CsrGraph<T>::Index;
+
+    std::vector<T> labels;
+    std::vector<std::size_t> offsets{0};
+    std::vector<Index> neighbors;
+    std::vector<Index> ids(nodes.size(), CsrGraph<T>::npos);
+
+    for (auto &pair : *vertices) {
+        ids[pair.second->index] = static_cast<Index>(labels.size());
+        labels.push_back(pair.first);
+    }
 
-    for (auto &neighbor : *adjacencyList->at(node)) {
-        if (!visited.count(neighbor))
-            return hasCycle(neighbor, visiting, visited);
+    for (auto &pair : *vertices) {
+        for (auto id : adjacency.successors(idOf(pair.second)))
+            neighbors.push_back(ids[id]);
+        offsets.push_back(neighbors.size());
     }
 
-    visiting.erase(node);
-    visited.insert(node);
+    std::vector<int> weights(neighbors.size(), 1);
+    return CsrGraph<T>{std::move(labels), std::move(offsets), std::move(neighbors), std::move(weights), true};
 }
@@ -32,6 +32,11 @@
  *      Add node         O(V^2)     |     O(K)       O(1)
  *      Remove node      O(V^2)     |     O(K)       O(V^2)
  *
+ *  This Graph keeps its adjacency in an AdjacencyTable: contiguous successor
+ *  and predecessor vectors per node plus a hash of the edges, so adding,
+ *  removing and querying an edge are O(1) on average and removing a node is
+ *  O(K). A pair of nodes holds at most one edge.
+ *
  *
  * https://en.wikipedia.org/wiki/Graph
  *
@@ -45,10 +50,21 @@
 
 #include <iostream>
 #include <map>
-#include <list>
-#include <set>
-#include <stack>
 #include <queue>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <limits>
+
+#include "CsrGraph.h"
+#include "CsrGraph.cpp"
+#include "AdjacencyTable.h"
+#include "AdjacencyTable.cpp"
+#include "Parallel.h"
+#include "Parallel.cpp"
 
 template<typename GRAPH>
 class Node {
@@ -60,12 +76,34 @@ public:
 public:
 
     Node() = default;
-    explicit Node(const T& label) : label { label } {};
+    Node(const T& label, std::size_t index) : label { label }, index { index } {};
     ~Node() = default;
 
 public:
 
     const T& label;
+    std::size_t index;
+};
+
+/*
+ * Base visitor for Graph<T>::depthFirst / breadthFirst, every hook does nothing.
+ * Derive from it and hide the hooks you need; the traversal is a template over
+ * the visitor type, so the calls are resolved (and inlined) at compile time.
+ *
+ *  discover(label)        first time the vertex is reached
+ *  examineEdge(from, to)  every edge leaving a discovered vertex
+ *  finish(label)          every edge of the vertex has been examined
+ */
+template<typename T>
+class GraphVisitor {
+
+public:
+
+    void discover(const T &) {}
+
+    void examineEdge(const T &, const T &) {}
+
+    void finish(const T &) {}
 };
 
 template<typename T>
@@ -77,11 +115,18 @@ public:
     using Node = Node<Graph<T>>;
     using iterator = typename std::map<T, Node*>::iterator;
 
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
 public:
 
     Graph();
     ~Graph();
 
+    Graph(const Graph &other) = delete;
+    Graph &operator=(const Graph &other) = delete;
+
+    Graph(Graph &&other) noexcept;
+
 public:
 
     void addNode(const T &label);
@@ -94,6 +139,8 @@ public:
 
     void removeEdge(const T &from, const T &to);
 
+    bool hasEdge(const T &from, const T &to);
+
     void print() const;
 
     void DFSRec(const T& root);
@@ -102,25 +149,110 @@ public:
 
     void BFS(const T &root);
 
+    /*
+     * Traversals driving a visitor (see GraphVisitor). The visited bitmap, the
+     * stack and the queue belong to the graph and are reused from one call to
+     * the next, so a traversal does not allocate once they have grown to size.
+     */
+    template<typename Visitor>
+    void depthFirst(const T &root, Visitor &visitor);
+
+    template<typename Visitor>
+    void breadthFirst(const T &root, Visitor &visitor);
+
+    /*
+     * Throws if the graph has a cycle
+     */
     std::vector<T> topologicalSort();
 
+    /*
+     * Groups the nodes by depth in the DAG: every edge goes from a level to a
+     * later one, so the nodes of a level do not depend on each other and can
+     * be processed together. Throws if the graph has a cycle.
+     */
+    std::vector<std::vector<T>> topologicalLevels(unsigned threads = std::thread::hardware_concurrency());
+
     bool hasCycle();
 
+    /*
+     * Acyclic mode: the graph keeps a topological order of its nodes up to date
+     * (Pearce-Kelly) and addEdge throws, leaving the graph untouched, when the
+     * new edge would close a cycle. Only the nodes ordered between the two ends
+     * of the edge are visited, and none when the edge already agrees with the
+     * order. Turning it on throws if the graph already has a cycle.
+     */
+    void setAcyclic(bool enabled);
+
+    [[nodiscard]] bool isAcyclic() const;
+
+    /*
+     * Index of the node in the flat arrays below: dense in [0, number of nodes
+     * ever alive at once), the index of a removed node is reused
+     */
+    std::size_t indexOf(const T &label);
+
+    /*
+     * components[indexOf(label)] is the strongly connected component of every
+     * node (npos for unused indices), returns the number of components.
+     * Components are numbered in topological order: every edge between two
+     * components goes from a lower id to a higher one.
+     */
+    std::size_t stronglyConnectedComponents(std::vector<std::size_t> &components);
+
+    /*
+     * The DAG of the strongly connected components, node i being component i
+     */
+    Graph<std::size_t> condense();
+
+    /*
+     * Packs the graph into a read-only CsrGraph (directed, every weight is 1),
+     * which can also be saved to disk and reopened with CsrGraph<T>::open
+     */
+    CsrGraph<T> freeze() const;
+
 private:
 
-    size_t mCounter;
-    std::map<Node*, std::list<Node*>* > *adjacencyList;
+    using Id = std::uint32_t;
+
     std::map<T, Node*> *vertices;
+    std::vector<Node*> nodes;
+    std::vector<std::size_t> freeIndices;
+    AdjacencyTable<Id> adjacency;
+
+    std::vector<std::uint64_t> visited;
+    std::vector<std::pair<Node*, std::size_t>> traversalStack;
+    std::vector<Node*> traversalQueue;
+
+    bool acyclic;
+    std::vector<std::size_t> order;
+    std::size_t nextOrder;
+    std::vector<std::uint32_t> marks;
+    std::uint32_t markEpoch;
+    std::vector<Id> forwardSet;
+    std::vector<Id> backwardSet;
+
+private:
+
+    class LabelPrinter : public GraphVisitor<T> {
+    public:
+        void discover(const T &label) { std::cout << label << std::endl; }
+    };
 
 private:
 
     iterator getNode(const T &value);
 
-    void DFSRec(Node *root, std::set<Node*> visited);
+    Node *findNode(const T &label);
+
+    static Id idOf(const Node *node);
+
+    void resetVisited();
+
+    bool markVisited(const Node *node);
 
-    void topologicalSort(Node* node, std::stack<Node *> &stack, std::set<Node*> &visited);
+    bool reorder(Id from, Id to);
 
-    bool hasCycle(Node *node, std::set<Node*> &visiting, std::set<Node*> &visited);
+    void collect(Id start, std::size_t bound, bool forward, std::vector<Id> &found);
 };
 
 
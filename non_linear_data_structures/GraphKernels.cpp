@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Graph Kernels (iterative analytics over a sparse matrix vector engine)
+ *
+ * https://en.wikipedia.org/wiki/PageRank
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_GRAPHKERNELS_CPP
+#define DATA__STRUCTURES_GRAPHKERNELS_CPP
+
+#include "GraphKernels.h"
+
+/*
+ * The CSC arrays are the CSR arrays of the transpose.
+ */
+
+template<typename T>
+GraphKernels<T>::GraphKernels(const CsrGraph<T> &graph, unsigned threads)
+        : graph{graph}, threads{std::max(threads, 1u)} {
+    auto size = graph.nodeCount();
+    auto reverse = graph.transpose();
+
+    offsets.reserve(size + 1);
+    sources.reserve(graph.edgeCount());
+    values.reserve(graph.edgeCount());
+    inverseOutDegrees.resize(size);
+
+    offsets.push_back(0);
+    for (Index node = 0; node < size; node++) {
+        for (auto edge = reverse.firstEdge(node); edge < reverse.lastEdge(node); edge++) {
+            sources.push_back(reverse.target(edge));
+            values.push_back(static_cast<float>(reverse.weight(edge)));
+        }
+        offsets.push_back(sources.size());
+
+        auto degree = graph.lastEdge(node) - graph.firstEdge(node);
+        inverseOutDegrees[node] = degree == 0 ? 0.0f : 1.0f / static_cast<float>(degree);
+        if (degree == 0)
+            deadEnds.push_back(node);
+    }
+}
+
+
+template<typename T>
+void GraphKernels<T>::multiply(const std::vector<float> &x, std::vector<float> &y) const {
+    if (x.size() != nodeCount())
+        throw std::runtime_error{"Vector size does not match the graph"};
+
+    y.resize(nodeCount());
+    pull<true>(x.data(), y.data());
+}
+
+/*
+ * Four independent accumulators: the additions of one row do not wait on each
+ * other, and the compiler is free to keep them in vector registers.
+ */
+
+template<typename T>
+template<bool WEIGHTED>
+void GraphKernels<T>::pull(const float *x, float *y) const {
+    parallelFor(nodeCount(), threads, [&](std::size_t begin, std::size_t end, unsigned) {
+        for (auto node = begin; node < end; node++) {
+            auto edge = offsets[node];
+            auto last = offsets[node + 1];
+            float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+
+            for (; edge + 4 <= last; edge += 4) {
+                if constexpr (WEIGHTED) {
+                    sum0 += values[edge] * x[sources[edge]];
+                    sum1 += values[edge + 1] * x[sources[edge + 1]];
+                    sum2 += values[edge + 2] * x[sources[edge + 2]];
+                    sum3 += values[edge + 3] * x[sources[edge + 3]];
+                } else {
+                    sum0 += x[sources[edge]];
+                    sum1 += x[sources[edge + 1]];
+                    sum2 += x[sources[edge + 2]];
+                    sum3 += x[sources[edge + 3]];
+                }
+            }
+            for (; edge < last; edge++)
+                sum0 += WEIGHTED ? values[edge] * x[sources[edge]] : x[sources[edge]];
+
+            y[node] = (sum0 + sum1) + (sum2 + sum3);
+        }
+    }, minimumChunk);
+}
+
+
+template<typename T>
+typename GraphKernels<T>::Scores GraphKernels<T>::pageRank(float damping, double tolerance,
+                                                           std::size_t maxIterations) const {
+    std::vector<float> teleport(nodeCount(), nodeCount() == 0 ? 0.0f : 1.0f / static_cast<float>(nodeCount()));
+    return rank(teleport, damping, tolerance, maxIterations);
+}
+
+
+template<typename T>
+typename GraphKernels<T>::Scores GraphKernels<T>::personalizedPageRank(const std::vector<T> &seeds, float damping,
+                                                                       double tolerance,
+                                                                       std::size_t maxIterations) const {
+    if (seeds.empty())
+        throw std::runtime_error{"Personalized PageRank needs at least one seed"};
+
+    std::vector<float> teleport(nodeCount(), 0.0f);
+    for (auto &seed : seeds)
+        teleport[graph.indexOf(seed)] += 1.0f / static_cast<float>(seeds.size());
+
+    return rank(teleport, damping, tolerance, maxIterations);
+}
+
+/*
+ * Power iteration on
+ *      rank' = (1 - d) * teleport + d * (A^T (rank / outDegree) + deadEndMass * teleport)
+ * the ranks always sum to 1.
+ */
+
+template<typename T>
+typename GraphKernels<T>::Scores GraphKernels<T>::rank(const std::vector<float> &teleport, float damping,
+                                                       double tolerance, std::size_t maxIterations) const {
+    Scores scores{teleport, 0, 0.0};
+    std::vector<float> contributions(nodeCount());
+    std::vector<float> next(nodeCount());
+
+    while (scores.iterations < maxIterations) {
+        auto &ranks = scores.values;
+
+        parallelFor(nodeCount(), threads, [&](std::size_t begin, std::size_t end, unsigned) {
+            for (auto node = begin; node < end; node++)
+                contributions[node] = ranks[node] * inverseOutDegrees[node];
+        }, minimumChunk);
+
+        double deadEndMass{};
+        for (auto node : deadEnds)
+            deadEndMass += ranks[node];
+
+        pull<false>(contributions.data(), next.data());
+
+        auto base = static_cast<float>(1.0 - damping + damping * deadEndMass);
+        scores.error = parallelSum(nodeCount(), threads, [&](std::size_t begin, std::size_t end, unsigned) {
+            double error{};
+            for (auto node = begin; node < end; node++) {
+                next[node] = base * teleport[node] + damping * next[node];
+                error += std::fabs(next[node] - ranks[node]);
+            }
+            return error;
+        }, minimumChunk);
+
+        ranks.swap(next);
+        scores.iterations++;
+        if (scores.error < tolerance)
+            break;
+    }
+
+    return scores;
+}
+
+/*
+ * The labels of the in-neighbors are copied into a per thread buffer and
+ * sorted, the most frequent one is then the longest run. Ties go to a hash of
+ * (vertex, label) rather than to the smallest label, which would let low
+ * labels flood across the sparse cuts between communities.
+ */
+
+template<typename T>
+typename GraphKernels<T>::Communities GraphKernels<T>::labelPropagation(std::size_t maxIterations) const {
+    std::vector<std::atomic<Index>> labels(nodeCount());
+    for (Index node = 0; node < nodeCount(); node++)
+        labels[node].store(node, std::memory_order_relaxed);
+
+    Communities communities{{}, 0};
+    while (communities.iterations < maxIterations) {
+        communities.iterations++;
+
+        auto changed = parallelSum(nodeCount(), threads, [&](std::size_t begin, std::size_t end, unsigned) {
+            std::vector<Index> neighborLabels;
+            double changes{};
+
+            for (auto node = begin; node < end; node++) {
+                if (offsets[node] == offsets[node + 1])
+                    continue;
+
+                neighborLabels.clear();
+                for (auto edge = offsets[node]; edge < offsets[node + 1]; edge++)
+                    neighborLabels.push_back(labels[sources[edge]].load(std::memory_order_relaxed));
+                std::sort(neighborLabels.begin(), neighborLabels.end());
+
+                auto current = labels[node].load(std::memory_order_relaxed);
+                auto best = current;
+                std::size_t bestCount{};
+                std::size_t currentCount{};
+
+                for (std::size_t i = 0, j; i < neighborLabels.size(); i = j) {
+                    for (j = i + 1; j < neighborLabels.size() && neighborLabels[j] == neighborLabels[i]; j++);
+
+                    auto count = j - i;
+                    if (neighborLabels[i] == current)
+                        currentCount = count;
+                    if (count > bestCount
+                        || (count == bestCount && tieBreak(node, neighborLabels[i]) < tieBreak(node, best))) {
+                        best = neighborLabels[i];
+                        bestCount = count;
+                    }
+                }
+
+                if (currentCount < bestCount) {
+                    labels[node].store(best, std::memory_order_relaxed);
+                    changes++;
+                }
+            }
+            return changes;
+        }, minimumChunk);
+
+        if (changed == 0)
+            break;
+    }
+
+    communities.labels.reserve(nodeCount());
+    for (auto &label : labels)
+        communities.labels.push_back(label.load(std::memory_order_relaxed));
+    return communities;
+}
+
+
+/*
+ * splitmix64 finalizer
+ */
+
+template<typename T>
+std::uint64_t GraphKernels<T>::tieBreak(std::size_t node, Index label) {
+    auto hash = static_cast<std::uint64_t>(node) << 32 ^ label;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    return hash ^ (hash >> 31);
+}
+
+
+template<typename T>
+std::size_t GraphKernels<T>::nodeCount() const {
+    return offsets.size() - 1;
+}
+
+#endif //DATA__STRUCTURES_GRAPHKERNELS_CPP
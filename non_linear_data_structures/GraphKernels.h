@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Graph Kernels (iterative analytics over a sparse matrix vector engine)
+ *
+ * The graph is seen as its adjacency matrix A (A[u][v] = weight of u -> v) and
+ * stored column by column (CSC): for every vertex v, the sources of its
+ * incoming edges and their weights, in contiguous arrays. One sweep computes
+ *      y[v] = sum over edges u -> v of A[u][v] * x[u]      (y = A^T x)
+ * by "pulling" from the in-neighbors: every y[v] is written by a single
+ * thread, so the vertices are split between threads without any atomic, and
+ * the inner loop is a plain float reduction over contiguous memory.
+ *
+ * -> Kernels built on it:
+ *  1. PageRank, personalized PageRank (power iteration)
+ *  2. Label propagation (community detection)
+ *
+ * -> Features, being V the number of vertices and E the number of edges:
+ *      Build        O(V + E)
+ *      Sweep        O(V + E), split across threads
+ *      Space        O(V + E)
+ *
+ * https://en.wikipedia.org/wiki/Sparse_matrix
+ * https://en.wikipedia.org/wiki/PageRank
+ * https://en.wikipedia.org/wiki/Label_propagation_algorithm
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_GRAPHKERNELS_H
+#define DATA__STRUCTURES_GRAPHKERNELS_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "CsrGraph.h"
+#include "CsrGraph.cpp"
+#include "Parallel.h"
+#include "Parallel.cpp"
+
+template<typename T>
+class GraphKernels {
+
+public:
+
+    using VT = T;
+    using Index = typename CsrGraph<T>::Index;
+
+    /*
+     * values[v] for every vertex id, with the number of sweeps run and the L1
+     * distance between the last two iterates
+     */
+    struct Scores {
+        std::vector<float> values;
+        std::size_t iterations;
+        double error;
+    };
+
+    /*
+     * labels[v] is the community of vertex v, named after one of its vertex ids
+     */
+    struct Communities {
+        std::vector<Index> labels;
+        std::size_t iterations;
+    };
+
+public:
+
+    explicit GraphKernels(const CsrGraph<T> &graph, unsigned threads = std::thread::hardware_concurrency());
+
+public:
+
+    /*
+     * y = A^T x, x and y hold one value per vertex id
+     */
+    void multiply(const std::vector<float> &x, std::vector<float> &y) const;
+
+    /*
+     * Edge weights are ignored, the rank of a vertex without out edges is
+     * spread over every vertex. Stops after maxIterations sweeps or once the
+     * L1 change of the ranks drops under tolerance.
+     */
+    Scores pageRank(float damping = 0.85f, double tolerance = 1e-6, std::size_t maxIterations = 100) const;
+
+    /*
+     * Same, but teleporting (and spreading dead ends) to the seeds only
+     */
+    Scores personalizedPageRank(const std::vector<T> &seeds, float damping = 0.85f, double tolerance = 1e-6,
+                                std::size_t maxIterations = 100) const;
+
+    /*
+     * Every vertex takes the most frequent label among its in-neighbors (a
+     * pseudo random one on ties, its own if it is among the most frequent) until no
+     * label changes. Labels are updated in place, so with several threads the
+     * result depends on scheduling. Meant for undirected graphs.
+     */
+    Communities labelPropagation(std::size_t maxIterations = 20) const;
+
+    [[nodiscard]] std::size_t nodeCount() const;
+
+private:
+
+    static constexpr std::size_t minimumChunk = 4096;
+
+    CsrGraph<T> graph;
+    unsigned threads;
+    std::vector<std::size_t> offsets;
+    std::vector<Index> sources;
+    std::vector<float> values;
+    std::vector<float> inverseOutDegrees;
+    std::vector<Index> deadEnds;
+
+private:
+
+    template<bool WEIGHTED>
+    void pull(const float *x, float *y) const;
+
+    static std::uint64_t tieBreak(std::size_t node, Index label);
+
+    Scores rank(const std::vector<float> &teleport, float damping, double tolerance, std::size_t maxIterations) const;
+};
+
+
+#endif //DATA__STRUCTURES_GRAPHKERNELS_H
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Graph Loader (bulk construction of Graph / WeightedGraph from edge lists)
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_GRAPHLOADER_CPP
+#define DATA__STRUCTURES_GRAPHLOADER_CPP
+
+#include <fstream>
+#include <algorithm>
+
+#include "GraphLoader.h"
+
+/*
+ * Chunk i starts right after the first line break following i * size / threads,
+ * so no line is split between two threads.
+ */
+
+template<typename GRAPH>
+void GraphLoader<GRAPH>::loadText(const std::string &path, GRAPH &graph, unsigned threads) {
+    MappedFile file{path};
+    auto begin = file.data();
+    auto end = file.data() + file.size();
+
+    threads = std::max(threads, 1u);
+    std::vector<const char *> bounds{begin};
+    for (unsigned i = 1; i < threads; i++) {
+        auto bound = std::max(bounds.back(), begin + file.size() / threads * i);
+        while (bound < end && bound != begin && bound[-1] != '\n')
+            bound++;
+        bounds.push_back(bound);
+    }
+    bounds.push_back(end);
+
+    std::vector<std::vector<ParsedEdge>> chunks(threads);
+    std::vector<char> valid(threads, true);
+    std::vector<std::thread> workers;
+
+    for (unsigned i = 1; i < threads; i++)
+        workers.emplace_back([&, i]() { valid[i] = parseChunk(bounds[i], bounds[i + 1], chunks[i]); });
+    valid[0] = parseChunk(bounds[0], bounds[1], chunks[0]);
+    for (auto &worker : workers)
+        worker.join();
+
+    for (auto ok : valid)
+        if (!ok) throw std::runtime_error{"Malformed edge list " + path};
+
+    std::unordered_set<Label> seen;
+    for (auto &chunk : chunks)
+        for (auto &edge : chunk)
+            addEdge(graph, seen, edge);
+}
+
+
+template<typename GRAPH>
+void GraphLoader<GRAPH>::loadBinary(const std::string &path, GRAPH &graph) {
+    if constexpr (!std::is_integral_v<T>) {
+        throw std::runtime_error{"Binary edge lists need integer labels"};
+    } else {
+        MappedFile file{path};
+        constexpr std::size_t headerSize = 4 + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+        std::uint32_t fileVersion{};
+        std::uint64_t count{};
+        if (file.size() < headerSize || std::memcmp(file.data(), "EDGE", 4) != 0)
+            throw std::runtime_error{"Not a binary edge list " + path};
+
+        std::memcpy(&fileVersion, file.data() + 4, sizeof(fileVersion));
+        std::memcpy(&count, file.data() + 4 + sizeof(fileVersion), sizeof(count));
+        if (fileVersion != version)
+            throw std::runtime_error{"Unsupported binary edge list " + path};
+        if ((file.size() - headerSize) % sizeof(EdgeRecord) != 0 || count != (file.size() - headerSize) / sizeof(EdgeRecord))
+            throw std::runtime_error{"Truncated binary edge list " + path};
+
+        std::unordered_set<Label> seen;
+        for (std::uint64_t i = 0; i < count; i++) {
+            EdgeRecord record{};
+            std::memcpy(&record, file.data() + headerSize + i * sizeof(EdgeRecord), sizeof(EdgeRecord));
+            if (!std::in_range<Label>(record.from) || !std::in_range<Label>(record.to))
+                throw std::runtime_error{"Label out of range in " + path};
+            addEdge(graph, seen, ParsedEdge{static_cast<Label>(record.from), static_cast<Label>(record.to), record.weight});
+        }
+    }
+}
+
+
+template<typename GRAPH>
+void GraphLoader<GRAPH>::saveBinary(const std::string &path, const std::vector<EdgeRecord> &edges) {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (!out) throw std::runtime_error{"Cannot open " + path};
+
+    std::uint64_t count = edges.size();
+    out.write("EDGE", 4);
+    out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char *>(edges.data()), static_cast<std::streamsize>(edges.size() * sizeof(EdgeRecord)));
+
+    if (!out) throw std::runtime_error{"Cannot write " + path};
+}
+
+
+template<typename GRAPH>
+bool GraphLoader<GRAPH>::parseChunk(const char *begin, const char *end, std::vector<ParsedEdge> &edges) {
+    auto current = begin;
+
+    while (current < end) {
+        skipBlanks(current, end);
+        if (current == end)
+            break;
+
+        if (*current == '\n') {
+            current++;
+            continue;
+        }
+
+        if (*current == '#' || *current == '%') {
+            while (current < end && *current != '\n')
+                current++;
+            continue;
+        }
+
+        ParsedEdge edge{Label{}, Label{}, 1};
+        if (!parseLabel(current, end, edge.from))
+            return false;
+        skipBlanks(current, end);
+        if (!parseLabel(current, end, edge.to))
+            return false;
+        skipBlanks(current, end);
+
+        if (current < end && *current != '\n') {
+            if (!parseInteger(current, end, edge.weight))
+                return false;
+            skipBlanks(current, end);
+        }
+
+        if (current < end && *current != '\n')
+            return false;
+
+        edges.push_back(edge);
+    }
+
+    return true;
+}
+
+
+template<typename GRAPH>
+bool GraphLoader<GRAPH>::parseLabel(const char *&current, const char *end, Label &label) {
+    if constexpr (std::is_integral_v<T>) {
+        return parseInteger(current, end, label);
+    } else {
+        auto begin = current;
+        while (current < end && *current != ' ' && *current != '\t' && *current != '\r' && *current != '\n')
+            current++;
+        label = Label{begin, static_cast<std::size_t>(current - begin)};
+        return current != begin;
+    }
+}
+
+/*
+ * [+-]digits, followed by a blank, a line break or the end of the chunk. The
+ * magnitude is checked against the limit of I before every digit, so a value
+ * that does not fit is rejected instead of overflowing or being truncated.
+ */
+
+template<typename GRAPH>
+template<typename I>
+bool GraphLoader<GRAPH>::parseInteger(const char *&current, const char *end, I &value) {
+    using Magnitude = std::make_unsigned_t<I>;
+
+    bool negative = false;
+    if (current < end && (*current == '-' || *current == '+'))
+        negative = *current++ == '-';
+
+    Magnitude limit = negative ? static_cast<Magnitude>(Magnitude{0} - static_cast<Magnitude>(std::numeric_limits<I>::min()))
+                               : static_cast<Magnitude>(std::numeric_limits<I>::max());
+
+    auto digits = current;
+    Magnitude magnitude = 0;
+    while (current < end && *current >= '0' && *current <= '9') {
+        auto digit = static_cast<Magnitude>(*current++ - '0');
+        if (digit > limit || magnitude > (limit - digit) / 10)
+            return false;
+        magnitude = static_cast<Magnitude>(magnitude * 10 + digit);
+    }
+
+    value = static_cast<I>(negative ? static_cast<Magnitude>(Magnitude{0} - magnitude) : magnitude);
+
+    return current != digits
+           && (current == end || *current == ' ' || *current == '\t' || *current == '\r' || *current == '\n');
+}
+
+
+template<typename GRAPH>
+void GraphLoader<GRAPH>::skipBlanks(const char *&current, const char *end) {
+    while (current < end && (*current == ' ' || *current == '\t' || *current == '\r'))
+        current++;
+}
+
+/*
+ * Nodes are added the first time their label shows up. WeightedGraph takes the
+ * weight, Graph has no weights and only gets the two labels.
+ */
+
+template<typename GRAPH>
+void GraphLoader<GRAPH>::addEdge(GRAPH &graph, std::unordered_set<Label> &seen, const ParsedEdge &edge) {
+    T from{edge.from};
+    T to{edge.to};
+
+    if (seen.insert(edge.from).second)
+        graph.addNode(from);
+    if (seen.insert(edge.to).second)
+        graph.addNode(to);
+
+    if constexpr (requires { graph.addEdge(from, to, edge.weight); })
+        graph.addEdge(from, to, edge.weight);
+    else
+        graph.addEdge(from, to);
+}
+
+#endif //DATA__STRUCTURES_GRAPHLOADER_CPP
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Graph Loader (bulk construction of Graph / WeightedGraph from edge lists)
+ *
+ * -> Text edge list, one edge per line:
+ *      from to [weight]
+ *    the weight defaults to 1 and is ignored by an unweighted Graph; empty lines
+ *    and lines starting with '#' or '%' are skipped. Integer labels and weights
+ *    that do not fit their type make the file malformed.
+ *
+ * -> Binary edge list (native byte order):
+ *      "EDGE" | uint32 version | uint64 count | count x {uint32 from, uint32 to, int32 weight}
+ *    only for integer labels.
+ *
+ * The file is memory mapped and cut into one chunk per thread at line
+ * boundaries; every chunk is parsed in parallel without allocating per token
+ * (string labels are views into the mapping until they are inserted). The graph
+ * is then built in one pass, in file order.
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_GRAPHLOADER_H
+#define DATA__STRUCTURES_GRAPHLOADER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <unordered_set>
+#include <stdexcept>
+#include <limits>
+#include <utility>
+
+#include "MappedFile.cpp"
+
+struct EdgeRecord {
+    std::uint32_t from;
+    std::uint32_t to;
+    std::int32_t weight;
+};
+
+template<typename GRAPH>
+class GraphLoader {
+
+public:
+
+    using T = typename GRAPH::VT;
+    using Label = std::conditional_t<std::is_integral_v<T>, T, std::string_view>;
+
+    static constexpr std::uint32_t version = 1;
+
+public:
+
+    static void loadText(const std::string &path, GRAPH &graph,
+                         unsigned threads = std::thread::hardware_concurrency());
+
+    static void loadBinary(const std::string &path, GRAPH &graph);
+
+    static void saveBinary(const std::string &path, const std::vector<EdgeRecord> &edges);
+
+private:
+
+    struct ParsedEdge {
+        Label from;
+        Label to;
+        int weight;
+    };
+
+private:
+
+    static bool parseChunk(const char *begin, const char *end, std::vector<ParsedEdge> &edges);
+
+    static bool parseLabel(const char *&current, const char *end, Label &label);
+
+    template<typename I>
+    static bool parseInteger(const char *&current, const char *end, I &value);
+
+    static void skipBlanks(const char *&current, const char *end);
+
+    static void addEdge(GRAPH &graph, std::unordered_set<Label> &seen, const ParsedEdge &edge);
+};
+
+
+#endif //DATA__STRUCTURES_GRAPHLOADER_H
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Indexed D-ary Heap (Type of Tree)
+ *
+ * -> Features:
+ * being N the number of items in the heap and D the arity (children per node)
+ * 1. Get min O(1)
+ * 2. Remove min O(D log_D N)
+ * 3. Insert O(log_D N)
+ * 4. Decrease key O(log_D N)
+ *
+ * https://en.wikipedia.org/wiki/D-ary_heap
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_INDEXEDHEAP_CPP
+#define DATA__STRUCTURES_INDEXEDHEAP_CPP
+
+#include "IndexedHeap.h"
+
+
+template<typename T, std::size_t D>
+IndexedHeap<T, D>::IndexedHeap() = default;
+
+template<typename T, std::size_t D>
+IndexedHeap<T, D>::IndexedHeap(std::size_t capacity) : positions(capacity, npos), keys(capacity) {
+    heap.reserve(capacity);
+}
+
+/*
+ * Useful formulas:
+ *
+ *  -> firstChildPosition = (parentPosition * D) + 1
+ *  -> lastChildPosition = (parentPosition * D) + D
+ *  -> parentPosition = (position - 1) / D
+ *
+ *  heap[position] is an item index, positions[index] is where the item sits in
+ *  heap (npos when it is not in the heap) and keys[index] is its priority.
+ */
+
+template<typename T, std::size_t D>
+void IndexedHeap<T, D>::insert(std::size_t index, const T &key) {
+    if (index >= capacity()) throw std::runtime_error{"Index out of range"};
+    if (contains(index)) throw std::runtime_error{"Item already in the heap"};
+
+    keys[index] = key;
+    positions[index] = heap.size();
+    heap.push_back(index);
+
+    bubbleUp(heap.size() - 1);
+}
+
+
+template<typename T, std::size_t D>
+void IndexedHeap<T, D>::decreaseKey(std::size_t index, const T &key) {
+    if (!contains(index)) throw std::runtime_error{"No such item in the heap"};
+    if (keys[index] < key) throw std::runtime_error{"New key is greater than the current one"};
+
+    keys[index] = key;
+    bubbleUp(positions[index]);
+}
+
+
+template<typename T, std::size_t D>
+bool IndexedHeap<T, D>::update(std::size_t index, const T &key) {
+    if (!contains(index)) {
+        insert(index, key);
+        return true;
+    }
+
+    if (!(key < keys[index]))
+        return false;
+
+    keys[index] = key;
+    bubbleUp(positions[index]);
+    return true;
+}
+
+
+template<typename T, std::size_t D>
+std::size_t IndexedHeap<T, D>::remove() {
+    if (isEmpty()) throw std::runtime_error{"Heap empty can't remove"};
+
+    auto toRemove = heap.front();
+    swapHeapNodes(0, heap.size() - 1);
+    heap.pop_back();
+    positions[toRemove] = npos;
+
+    if (!heap.empty())
+        bubbleDown(0);
+
+    return toRemove;
+}
+
+
+template<typename T, std::size_t D>
+std::size_t IndexedHeap<T, D>::getMinIndex() const {
+    if (isEmpty()) throw std::runtime_error{"Heap empty"};
+    return heap.front();
+}
+
+
+template<typename T, std::size_t D>
+const T &IndexedHeap<T, D>::getMin() const {
+    return keys[getMinIndex()];
+}
+
+
+template<typename T, std::size_t D>
+const T &IndexedHeap<T, D>::keyOf(std::size_t index) const {
+    if (!contains(index)) throw std::runtime_error{"No such item in the heap"};
+    return keys[index];
+}
+
+
+template<typename T, std::size_t D>
+bool IndexedHeap<T, D>::contains(std::size_t index) const {
+    return index < positions.size() && positions[index] != npos;
+}
+
+
+template<typename T, std::size_t D>
+bool IndexedHeap<T, D>::isEmpty() const {
+    return heap.empty();
+}
+
+
+template<typename T, std::size_t D>
+std::size_t IndexedHeap<T, D>::size() const {
+    return heap.size();
+}
+
+
+template<typename T, std::size_t D>
+std::size_t IndexedHeap<T, D>::capacity() const {
+    return positions.size();
+}
+
+/*
+ * Growing keeps the items already in the heap, shrinking clears the heap first.
+ */
+
+template<typename T, std::size_t D>
+void IndexedHeap<T, D>::resize(std::size_t capacity) {
+    if (capacity < this->capacity())
+        clear();
+
+    positions.resize(capacity, npos);
+    keys.resize(capacity);
+}
+
+/*
+ * Only the items still in the heap are touched, so clearing after a search
+ * that stopped early costs O(N) and not O(capacity).
+ */
+
+template<typename T, std::size_t D>
+void IndexedHeap<T, D>::clear() {
+    for (auto index : heap)
+        positions[index] = npos;
+    heap.clear();
+}
+
+
+template<typename T, std::size_t D>
+void IndexedHeap<T, D>::bubbleUp(std::size_t position) {
+    auto index = heap[position];
+
+    while (position > 0) {
+        auto parentPosition = getParentPosition(position);
+        if (!(keys[index] < keys[heap[parentPosition]]))
+            break;
+
+        heap[position] = heap[parentPosition];
+        positions[heap[position]] = position;
+        position = parentPosition;
+    }
+
+    heap[position] = index;
+    positions[index] = position;
+}
+
+
+template<typename T, std::size_t D>
+void IndexedHeap<T, D>::bubbleDown(std::size_t position) {
+    auto index = heap[position];
+
+    while (true) {
+        auto childPosition = getSmallestChildPosition(position);
+        if (childPosition == npos || !(keys[heap[childPosition]] < keys[index]))
+            break;
+
+        heap[position] = heap[childPosition];
+        positions[heap[position]] = position;
+        position = childPosition;
+    }
+
+    heap[position] = index;
+    positions[index] = position;
+}
+
+
+template<typename T, std::size_t D>
+void IndexedHeap<T, D>::swapHeapNodes(std::size_t position, std::size_t other) {
+    std::swap(heap[position], heap[other]);
+    positions[heap[position]] = position;
+    positions[heap[other]] = other;
+}
+
+
+template<typename T, std::size_t D>
+std::size_t IndexedHeap<T, D>::getSmallestChildPosition(std::size_t position) const {
+    auto first = getFirstChildPosition(position);
+    if (first >= heap.size())
+        return npos;
+
+    auto last = std::min(first + D, heap.size());
+    auto smallest = first;
+    for (auto child = first + 1; child < last; child++)
+        if (keys[heap[child]] < keys[heap[smallest]])
+            smallest = child;
+
+    return smallest;
+}
+
+
+template<typename T, std::size_t D>
+constexpr std::size_t IndexedHeap<T, D>::getFirstChildPosition(std::size_t position) const {
+    return (position * D) + 1;
+}
+
+
+template<typename T, std::size_t D>
+constexpr std::size_t IndexedHeap<T, D>::getParentPosition(std::size_t position) const {
+    return (position - 1) / D;
+}
+
+#endif //DATA__STRUCTURES_INDEXEDHEAP_CPP
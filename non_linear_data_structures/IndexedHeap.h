@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Indexed D-ary Heap (Type of Tree)
+ *
+ * A min heap of items identified by an index in [0, capacity), every item
+ * having a key (its priority). The heap remembers where each item sits, so the
+ * key of an item already in the heap can be lowered in place (decreaseKey)
+ * instead of pushing a duplicate entry.
+ *
+ * -> Indexed Heaps Applications:
+ *  1. Graph algorithms (Dijkstra's shortest path, Prim's spanning tree)
+ *  2. Priority queues with updatable priorities
+ *
+ * -> Features:
+ * being N the number of items in the heap and D the arity (children per node)
+ * Height = log_D(N)
+ * 1. Get min O(1)
+ * 2. Remove min O(D log_D N)
+ * 3. Insert O(log_D N)
+ * 4. Decrease key O(log_D N)
+ * 5. Contains O(1)
+ *
+ * A larger D makes the tree shallower (cheaper decreaseKey) and keeps the
+ * children of a node next to each other in memory, D = 4 is a good default.
+ *
+ * https://en.wikipedia.org/wiki/D-ary_heap
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_INDEXEDHEAP_H
+#define DATA__STRUCTURES_INDEXEDHEAP_H
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+template<typename T, std::size_t D = 4>
+class IndexedHeap {
+
+    static_assert(D >= 2, "A heap needs at least two children per node");
+
+public:
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+public:
+
+    IndexedHeap();
+
+    explicit IndexedHeap(std::size_t capacity);
+
+public:
+
+    void insert(std::size_t index, const T &key);
+
+    void decreaseKey(std::size_t index, const T &key);
+
+    /*
+     * Inserts the item or lowers its key, returns false if the key was not lowered
+     */
+    bool update(std::size_t index, const T &key);
+
+    std::size_t remove();
+
+    [[nodiscard]] std::size_t getMinIndex() const;
+
+    const T &getMin() const;
+
+    const T &keyOf(std::size_t index) const;
+
+    [[nodiscard]] bool contains(std::size_t index) const;
+
+    [[nodiscard]] bool isEmpty() const;
+
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] std::size_t capacity() const;
+
+    void resize(std::size_t capacity);
+
+    void clear();
+
+private:
+
+    std::vector<std::size_t> heap;
+    std::vector<std::size_t> positions;
+    std::vector<T> keys;
+
+private:
+
+    void bubbleUp(std::size_t position);
+
+    void bubbleDown(std::size_t position);
+
+    void swapHeapNodes(std::size_t position, std::size_t other);
+
+    [[nodiscard]] std::size_t getSmallestChildPosition(std::size_t position) const;
+
+    [[nodiscard]] constexpr std::size_t getFirstChildPosition(std::size_t position) const;
+
+    [[nodiscard]] constexpr std::size_t getParentPosition(std::size_t position) const;
+};
+
+
+#endif //DATA__STRUCTURES_INDEXEDHEAP_H
@@ -0,0 +1,51 @@
+//
+// Read-only memory mapped file (POSIX mmap), unmapped when destroyed.
+//
+
+#ifndef DATA__STRUCTURES_MAPPEDFILE_CPP
+#define DATA__STRUCTURES_MAPPEDFILE_CPP
+
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path) : mData{nullptr}, mSize{} {
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error{"Cannot open " + path};
+
+        struct stat status{};
+        if (::fstat(fd, &status) < 0) {
+            ::close(fd);
+            throw std::runtime_error{"Cannot read " + path};
+        }
+
+        mSize = static_cast<std::size_t>(status.st_size);
+        if (mSize > 0) {
+            auto address = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error{"Cannot map " + path};
+            }
+            mData = static_cast<const char *>(address);
+        }
+        ::close(fd);
+    }
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile &operator=(const MappedFile &other) = delete;
+    MappedFile(MappedFile &&other) noexcept : mData{std::exchange(other.mData, nullptr)}, mSize{std::exchange(other.mSize, 0)} {}
+    ~MappedFile() { if (mData != nullptr) ::munmap(const_cast<char *>(mData), mSize); }
+
+    [[nodiscard]] const char *data() const { return mData; }
+    [[nodiscard]] std::size_t size() const { return mSize; }
+private:
+    const char *mData;
+    std::size_t mSize;
+};
+
+#endif //DATA__STRUCTURES_MAPPEDFILE_CPP
@@ -5,16 +5,17 @@
 #include "Node.h"
 
 template<typename GRAPH>
-Node<GRAPH>::Node(const T& label) : label { label } {};
+Node<GRAPH>::Node(const T& label, std::size_t index, Arena &arena)
+        : label { label }, index { index }, edges { ArenaAllocator<Edge, Arena>{ &arena } } {};
 
 
 template<typename GRAPH>
 void Node<GRAPH>::addEdge(Node *to, int weight) {
-    edges.push_back(new Edge{ this, to, weight});
+    edges.emplace_back(this, to, weight);
 }
 
 
 template<typename GRAPH>
-std::vector<typename Node<GRAPH>::Edge*> &Node<GRAPH>::getEdges() {
+typename Node<GRAPH>::EdgeList &Node<GRAPH>::getEdges() {
     return edges;
 }
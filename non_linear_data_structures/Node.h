@@ -7,19 +7,24 @@
 
 #include <vector>
 
+#include "Arena.h"
+#include "Arena.cpp"
+
 template<typename GRAPH>
 class Node {
 
 public:
     using T = typename GRAPH::VT;
     using Edge = typename GRAPH::Edge;
+    using Arena = typename GRAPH::Arena;
+    using EdgeList = std::vector<Edge, ArenaAllocator<Edge, Arena>>;
 
     /*
      * This section is dedicated to the constructors and destructor of the Node class
      */
 public:
     Node();
-    explicit Node(const T& label);
+    Node(const T& label, std::size_t index, Arena &arena);
     ~Node();
 
     /*
@@ -28,15 +33,23 @@ public:
 public:
     const T& label;
 
+    /*
+     * Dense id in [0, V) assigned by the graph, used to index flat arrays
+     */
+    std::size_t index;
+
     void addEdge(Node *to, int weight);
 
-    std::vector<Edge*>& getEdges();
+    EdgeList& getEdges();
 
     /*
      * This section is dedicated to the private fields
      */
 private:
-    std::vector<Edge*> edges;
+    /*
+     * Edges are stored by value in arena memory, next to each other
+     */
+    EdgeList edges;
 };
 
 
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Parallel loops shared by the graph algorithms
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_PARALLEL_CPP
+#define DATA__STRUCTURES_PARALLEL_CPP
+
+#include "Parallel.h"
+
+
+template<typename Function>
+void parallelFor(std::size_t size, unsigned threads, Function function, std::size_t minimumChunk) {
+    threads = static_cast<unsigned>(std::clamp<std::size_t>(size / minimumChunk, 1, std::max(threads, 1u)));
+    if (threads == 1) {
+        function(0, size, 0);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    auto chunk = (size + threads - 1) / threads;
+    for (unsigned thread = 1; thread < threads; thread++)
+        workers.emplace_back(function, std::min(size, thread * chunk), std::min(size, (thread + 1) * chunk), thread);
+    function(0, std::min(size, chunk), 0);
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+/*
+ * One partial sum per thread, added in chunk order
+ */
+template<typename Function>
+double parallelSum(std::size_t size, unsigned threads, Function function, std::size_t minimumChunk) {
+    std::vector<double> sums(std::max(threads, 1u), 0.0);
+
+    parallelFor(size, threads, [&](std::size_t begin, std::size_t end, unsigned thread) {
+        sums[thread] = function(begin, end, thread);
+    }, minimumChunk);
+
+    double total{};
+    for (auto sum : sums)
+        total += sum;
+    return total;
+}
+
+#endif //DATA__STRUCTURES_PARALLEL_CPP
@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Parallel loops shared by the graph algorithms
+ *
+ * [0, size) is split in one contiguous chunk per thread and the caller runs the
+ * first chunk itself. Ranges smaller than minimumChunk per thread are not worth
+ * starting threads for: fewer threads are used, down to the caller alone.
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_PARALLEL_H
+#define DATA__STRUCTURES_PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <algorithm>
+
+/*
+ * function(begin, end, thread), thread in [0, threads)
+ */
+template<typename Function>
+void parallelFor(std::size_t size, unsigned threads, Function function, std::size_t minimumChunk = 1024);
+
+/*
+ * Sum of function(begin, end, thread) over the chunks
+ */
+template<typename Function>
+double parallelSum(std::size_t size, unsigned threads, Function function, std::size_t minimumChunk = 1024);
+
+
+#endif //DATA__STRUCTURES_PARALLEL_H
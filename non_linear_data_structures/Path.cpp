@@ -2,6 +2,9 @@
 // Created by moboustt on 10/9/20.
 //
 
+#ifndef DATA__STRUCTURES_PATH_CPP
+#define DATA__STRUCTURES_PATH_CPP
+
 #include <vector>
 #include <string>
 #include <iostream>
@@ -17,4 +20,6 @@ public:
     }
 private:
     std::vector<std::string> nodes;
-};
\ No newline at end of file
+};
+
+#endif //DATA__STRUCTURES_PATH_CPP
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Union Find (Disjoint Set Forest)
+ *
+ * https://en.wikipedia.org/wiki/Disjoint-set_data_structure
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_UNIONFIND_CPP
+#define DATA__STRUCTURES_UNIONFIND_CPP
+
+#include "UnionFind.h"
+
+
+template<typename INDEX>
+UnionFind<INDEX>::UnionFind() : sets{} {}
+
+
+template<typename INDEX>
+UnionFind<INDEX>::UnionFind(std::size_t size) : sets{} {
+    reset(size);
+}
+
+/*
+ * Two passes instead of recursion: find the root, then point every element of
+ * the path straight at it.
+ */
+
+template<typename INDEX>
+INDEX UnionFind<INDEX>::find(INDEX element) {
+    if (element >= parents.size())
+        throw std::runtime_error{"Invalid argument"};
+
+    auto root = element;
+    while (parents[root] != root)
+        root = parents[root];
+
+    while (parents[element] != root) {
+        auto next = parents[element];
+        parents[element] = root;
+        element = next;
+    }
+
+    return root;
+}
+
+/*
+ * The root of the shallower tree goes under the other one, so a tree of rank r
+ * holds at least 2^r elements and the rank fits in a byte.
+ */
+
+template<typename INDEX>
+bool UnionFind<INDEX>::unite(INDEX a, INDEX b) {
+    auto rootA = find(a);
+    auto rootB = find(b);
+
+    if (rootA == rootB)
+        return false;
+
+    if (ranks[rootA] < ranks[rootB])
+        std::swap(rootA, rootB);
+
+    parents[rootB] = rootA;
+    if (ranks[rootA] == ranks[rootB])
+        ranks[rootA]++;
+
+    sets--;
+    return true;
+}
+
+
+template<typename INDEX>
+bool UnionFind<INDEX>::connected(INDEX a, INDEX b) {
+    return find(a) == find(b);
+}
+
+
+template<typename INDEX>
+void UnionFind<INDEX>::reset(std::size_t size) {
+    parents.resize(size);
+    ranks.assign(size, 0);
+    for (std::size_t i = 0; i < size; i++)
+        parents[i] = static_cast<INDEX>(i);
+    sets = size;
+}
+
+
+template<typename INDEX>
+std::size_t UnionFind<INDEX>::size() const {
+    return parents.size();
+}
+
+
+template<typename INDEX>
+std::size_t UnionFind<INDEX>::setCount() const {
+    return sets;
+}
+
+#endif //DATA__STRUCTURES_UNIONFIND_CPP
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * DATA STRUCTURES IMPLEMENTATIONS
+ *
+ *   __                __
+ *  |  \  _  |_  _    (_  |_  _      _ |_      _  _  _
+ *  |__/ (_| |_ (_|   __) |_ |  |_| (_ |_ |_| |  (- _)
+ *
+ *
+ * Union Find (Disjoint Set Forest)
+ *
+ * Keeps the elements [0, size) split into disjoint sets, each set being a tree
+ * whose root represents it.
+ *
+ * -> Union Find Applications:
+ *  1. Kruskal's minimum spanning tree
+ *  2. Connected components, cycle detection in undirected graphs
+ *
+ * -> Features, being N the number of elements and a() the inverse Ackermann
+ *    function (a(N) <= 4 for any practical N):
+ * 1. Find O(a(N)) amortized, path compression
+ * 2. Unite O(a(N)) amortized, union by rank
+ * 3. Connected O(a(N)) amortized
+ *
+ * https://en.wikipedia.org/wiki/Disjoint-set_data_structure
+ *
+ * @author (moboustta6@gmail.com)
+ * @github MoBoustta
+ ******************************************************************************/
+
+#ifndef DATA__STRUCTURES_UNIONFIND_H
+#define DATA__STRUCTURES_UNIONFIND_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+
+template<typename INDEX = std::size_t>
+class UnionFind {
+
+public:
+
+    UnionFind();
+
+    explicit UnionFind(std::size_t size);
+
+public:
+
+    /*
+     * Representative of the set holding element
+     */
+    INDEX find(INDEX element);
+
+    /*
+     * Merges the sets of a and b, returns false if they were already the same set
+     */
+    bool unite(INDEX a, INDEX b);
+
+    bool connected(INDEX a, INDEX b);
+
+    /*
+     * Every element back in a set of its own
+     */
+    void reset(std::size_t size);
+
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] std::size_t setCount() const;
+
+private:
+
+    std::vector<INDEX> parents;
+    std::vector<std::uint8_t> ranks;
+    std::size_t sets;
+};
+
+
+#endif //DATA__STRUCTURES_UNIONFIND_H
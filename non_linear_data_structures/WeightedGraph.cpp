@@ -45,19 +45,32 @@
 
 template<typename T>
 WeightedGraph<T>::WeightedGraph() {
-    vertices = new std::map<T, Node *>{};
+    vertices = new VertexMap{ ArenaAllocator<std::pair<const T, Node *>, Arena>{ &arena } };
 }
 
 
+/*
+ * Nodes and edges are not deleted one by one, the arena releases them with its blocks.
+ */
 template<typename T>
 WeightedGraph<T>::~WeightedGraph() {
     delete vertices;
 }
 
 
+/*
+ * The node keeps a reference to the key stored in the map (not to the caller's
+ * argument) and gets the next dense index.
+ */
+
 template<typename T>
 void WeightedGraph<T>::addNode(const T &label) {
-    vertices->insert(std::make_pair( label, new Node { label } ) );
+    auto pair = vertices->insert(std::make_pair(label, nullptr));
+    if (!pair.second)
+        return;
+
+    pair.first->second = arena.template create<Node>(pair.first->first, nodes.size(), arena);
+    nodes.push_back(pair.first->second);
 }
 
 
@@ -73,28 +86,173 @@ void WeightedGraph<T>::addEdge(const T &from, const T &to, const int& weight) {
     toPair->second->addEdge(fromPair->second, weight);
 }
 
+/*
+ * Every edge is stored at both of its ends, it is taken once from its lower
+ * index end (twice for a self loop, which is a cycle anyway).
+ */
+
 template<typename T>
 bool WeightedGraph<T>::hasCycle() {
+    UnionFind<std::size_t> sets{nodes.size()};
 
-    std::set<Node*> visited;
+    for (auto node : nodes)
+        for (auto &edge : node->getEdges())
+            if (node->index <= edge.to->index && !sets.unite(node->index, edge.to->index))
+                return true;
 
-    for (auto &nodePair : *vertices)
-        if (!visited.count(nodePair.second))
-            return hasCycle(nodePair.second, nodePair.second ,visited);
+    return false;
 }
 
+
 template<typename T>
-bool WeightedGraph<T>::hasCycle(Node *node, Node *parent, std::set<Node *> &visited) {
-    if (visited.count(node))
-        return true;
+std::size_t WeightedGraph<T>::indexOf(const T &label) {
+    return findNode(label)->index;
+}
 
-    visited.insert(node);
 
-    for (auto &neighbor : node->getEdges())
-        if(neighbor->to != parent)
-            return hasCycle(neighbor->to, node, visited);
+template<typename T>
+std::size_t WeightedGraph<T>::connectedComponents(std::vector<std::size_t> &components) {
+    UnionFind<std::size_t> sets{nodes.size()};
+
+    for (auto node : nodes)
+        for (auto &edge : node->getEdges())
+            sets.unite(node->index, edge.to->index);
+
+    std::vector<std::size_t> ids(nodes.size(), nodes.size());
+    std::size_t count{};
+    components.resize(nodes.size());
+
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        auto root = sets.find(i);
+        if (ids[root] == nodes.size())
+            ids[root] = count++;
+        components[i] = ids[root];
+    }
 
-    return false;
+    return count;
+}
+
+
+template<typename T>
+long long WeightedGraph<T>::getMinimumSpanningTreeKruskal(WeightedGraph<T> &tree, unsigned threads) {
+    std::vector<SpanningEdge> edges;
+    for (auto node : nodes)
+        for (auto &edge : node->getEdges())
+            if (node->index < edge.to->index)
+                edges.push_back(SpanningEdge{edge.weight, node->index, edge.to->index});
+
+    parallelSort(edges, threads, [](const SpanningEdge &lhs, const SpanningEdge &rhs) {
+        if (lhs.weight != rhs.weight)
+            return lhs.weight < rhs.weight;
+        return lhs.from != rhs.from ? lhs.from < rhs.from : lhs.to < rhs.to;
+    });
+
+    for (auto &pair : *vertices)
+        tree.addNode(pair.first);
+
+    UnionFind<std::size_t> sets{nodes.size()};
+    long long total{};
+    std::size_t treeEdges{};
+
+    for (auto &edge : edges) {
+        if (treeEdges + 1 >= nodes.size())
+            break;
+        if (!sets.unite(edge.from, edge.to))
+            continue;
+        tree.addEdge(nodes[edge.from]->label, nodes[edge.to]->label, edge.weight);
+        total += edge.weight;
+        treeEdges++;
+    }
+
+    return total;
+}
+
+/*
+ * One tree per component, each grown from its lowest index node.
+ */
+
+template<typename T>
+long long WeightedGraph<T>::getMinimumSpanningTreePrim(WeightedGraph<T> &tree) {
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t> parents(nodes.size(), none);
+    std::vector<char> inTree(nodes.size(), 0);
+    IndexedHeap<int> heap{nodes.size()};
+    long long total{};
+
+    for (auto &pair : *vertices)
+        tree.addNode(pair.first);
+
+    for (std::size_t root = 0; root < nodes.size(); root++) {
+        if (inTree[root])
+            continue;
+
+        heap.insert(root, 0);
+        while (!heap.isEmpty()) {
+            auto weight = heap.getMin();
+            auto current = heap.remove();
+            inTree[current] = 1;
+
+            if (parents[current] != none) {
+                tree.addEdge(nodes[parents[current]]->label, nodes[current]->label, weight);
+                total += weight;
+            }
+
+            for (auto &edge : nodes[current]->getEdges()) {
+                auto next = edge.to->index;
+                if (!inTree[next] && heap.update(next, edge.weight))
+                    parents[next] = current;
+            }
+        }
+    }
+
+    return total;
+}
+
+/*
+ * One sorted run per thread, then rounds of pairwise merges (each merge on its
+ * own thread) between the items and a buffer until a single run is left.
+ */
+
+template<typename T>
+template<typename Item, typename Compare>
+void WeightedGraph<T>::parallelSort(std::vector<Item> &items, unsigned threads, Compare compare) {
+    constexpr std::size_t minimumChunk = 16 * 1024;
+
+    threads = static_cast<unsigned>(std::clamp<std::size_t>(items.size() / minimumChunk, 1, std::max(threads, 1u)));
+    if (threads == 1) {
+        std::sort(items.begin(), items.end(), compare);
+        return;
+    }
+
+    std::vector<std::size_t> bounds;
+    for (unsigned i = 0; i <= threads; i++)
+        bounds.push_back(items.size() * i / threads);
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; i++)
+        workers.emplace_back([&, i]() {
+            std::sort(items.begin() + bounds[i], items.begin() + bounds[i + 1], compare);
+        });
+    for (auto &worker : workers)
+        worker.join();
+
+    std::vector<Item> buffer(items.size());
+    for (unsigned width = 1; width < threads; width *= 2) {
+        workers.clear();
+        for (unsigned i = 0; i < threads; i += 2 * width) {
+            auto low = bounds[i];
+            auto middle = bounds[std::min(i + width, threads)];
+            auto high = bounds[std::min(i + 2 * width, threads)];
+            workers.emplace_back([&, low, middle, high]() {
+                std::merge(items.begin() + low, items.begin() + middle, items.begin() + middle,
+                           items.begin() + high, buffer.begin() + low, compare);
+            });
+        }
+        for (auto &worker : workers)
+            worker.join();
+        items.swap(buffer);
+    }
 }
 
 
@@ -103,53 +261,302 @@ typename WeightedGraph<T>::iterator WeightedGraph<T>::getNode(const T &label) {
     return vertices->lower_bound(label);
 }
 
+template <typename T>
+typename WeightedGraph<T>::Node *WeightedGraph<T>::findNode(const T &label) {
+    auto pair = getNode(label);
+
+    if (pair == vertices->end() || pair->first != label)
+        throw std::runtime_error{ "Invalid argument" };
+
+    return pair->second;
+}
+
+/*
+ * Dijkstra's algorithm. The search state lives in flat arrays indexed by
+ * Node::index and reused between queries (see SearchSpace), so a query costs
+ * O((V+E) log V) without any map lookup or per-query allocation.
+ */
+
 template<typename T>
-Path WeightedGraph<T>::getShortestDistance(const T &from, const T &to) {
-    auto comparator = [](NodeEntry &nodeEntry, NodeEntry &other) { return nodeEntry.priority > other.priority; };
+Path WeightedGraph<T>::getShortestDistance(const T &from, const T &to, QueueMode mode) {
+    auto source = findNode(from);
+    auto target = findNode(to);
 
-    std::priority_queue<NodeEntry, std::vector<NodeEntry>, decltype(comparator)> priorityQueue(comparator);
-    std::map<Node *, int> distances;
-    std::map<Node *, Node *> previousNodes;
-    std::set<Node*> visited;
+    searchSpace.reset(nodes.size());
 
+    if (mode == QueueMode::Lazy)
+        searchLazy(source, target, searchSpace);
+    else
+        searchIndexed(source, target, searchSpace);
 
-    for (auto &vertexPair : *vertices) {
-        distances.insert(std::make_pair(vertexPair.second, std::numeric_limits<int>::max()));
-        previousNodes.insert(std::make_pair(vertexPair.second, nullptr));
-    }
+    Path path = buildPath(to, searchSpace);
+
+    return path;
+}
+
+template<typename T>
+void WeightedGraph<T>::searchLazy(Node *source, Node *target, SearchSpace &space) {
+    auto comparator = [](const NodeEntry &nodeEntry, const NodeEntry &other) { return nodeEntry.priority > other.priority; };
+    auto &priorityQueue = space.queue;
 
-    auto nodePair = getNode(from);
-    priorityQueue.push(NodeEntry{0, nodePair->second});
-    distances.at(nodePair->second) = 0;
+    space.relax(source->index, 0, nullptr);
+    priorityQueue.push_back(NodeEntry{0, source});
 
     while (!priorityQueue.empty()) {
-        auto current = priorityQueue.top().node;
-        priorityQueue.pop();
+        std::pop_heap(priorityQueue.begin(), priorityQueue.end(), comparator);
+        auto current = priorityQueue.back().node;
+        priorityQueue.pop_back();
+
+        if (space.isSettled(current->index))
+            continue;
+
+        space.settle(current->index);
+        if (current == target)
+            return;
+
+        for (auto &edge : current->getEdges()) {
+            if (!space.isSettled(edge.to->index)) {
+                auto distance = edge.weight + space.distance(current->index);
+                if (distance < space.distance(edge.to->index)) {
+                    space.relax(edge.to->index, distance, current);
+                    priorityQueue.push_back(NodeEntry{ distance, edge.to });
+                    std::push_heap(priorityQueue.begin(), priorityQueue.end(), comparator);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Same search driven by the indexed heap: a vertex already queued has its key
+ * lowered in place, so the heap never holds more than V entries and every pop
+ * settles a new vertex.
+ *
+ * Both searches stop as soon as the target is settled (pass nullptr to settle
+ * the whole graph).
+ */
+
+template<typename T>
+void WeightedGraph<T>::searchIndexed(Node *source, Node *target, SearchSpace &space) {
+    auto &heap = space.heap;
+
+    space.relax(source->index, 0, nullptr);
+    heap.insert(source->index, 0);
+
+    while (!heap.isEmpty()) {
+        auto current = nodes[heap.remove()];
+        space.settle(current->index);
+        if (current == target)
+            return;
+
+        for (auto &edge : current->getEdges()) {
+            if (!space.isSettled(edge.to->index)) {
+                auto distance = edge.weight + space.distance(current->index);
+                if (distance < space.distance(edge.to->index)) {
+                    space.relax(edge.to->index, distance, current);
+                    heap.update(edge.to->index, distance);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Bidirectional Dijkstra: a forward search from `from` and a backward search
+ * from `to` (the graph is undirected, so both use the same edges). The side
+ * with the smaller queue head advances; every edge reaching a vertex already
+ * seen by the other side is a candidate path. Once the two queue heads add up
+ * to at least the best candidate, no shorter path can exist.
+ */
+
+template<typename T>
+Path WeightedGraph<T>::getShortestDistanceBidirectional(const T &from, const T &to) {
+    auto source = findNode(from);
+    auto target = findNode(to);
+
+    auto &forward = searchSpace;
+    auto &backward = backwardSearchSpace;
+    forward.reset(nodes.size());
+    backward.reset(nodes.size());
+
+    forward.relax(source->index, 0, nullptr);
+    forward.heap.insert(source->index, 0);
+    backward.relax(target->index, 0, nullptr);
+    backward.heap.insert(target->index, 0);
+
+    int best = source == target ? 0 : std::numeric_limits<int>::max();
+    Node *meeting = source == target ? source : nullptr;
+
+    while (!forward.heap.isEmpty() && !backward.heap.isEmpty()) {
+        auto forwardMin = forward.heap.getMin();
+        auto backwardMin = backward.heap.getMin();
+
+        if (static_cast<long long>(forwardMin) + backwardMin >= best)
+            break;
+
+        if (forwardMin <= backwardMin)
+            relaxBidirectional(nodes[forward.heap.remove()], forward, backward, best, meeting);
+        else
+            relaxBidirectional(nodes[backward.heap.remove()], backward, forward, best, meeting);
+    }
+
+    if (meeting == nullptr)
+        return buildPath(to, forward);
+
+    return buildPath(meeting, forward, backward);
+}
+
+template<typename T>
+void WeightedGraph<T>::relaxBidirectional(Node *current, SearchSpace &space, const SearchSpace &other,
+                                          int &best, Node *&meeting) {
+    space.settle(current->index);
 
-        if (visited.count(current))
+    for (auto &edge : current->getEdges()) {
+        auto neighbor = edge.to;
+        if (space.isSettled(neighbor->index))
             continue;
 
-        visited.insert(current);
+        auto distance = edge.weight + space.distance(current->index);
+        if (distance < space.distance(neighbor->index)) {
+            space.relax(neighbor->index, distance, current);
+            space.heap.update(neighbor->index, distance);
+        }
+
+        auto otherDistance = other.distance(neighbor->index);
+        if (otherDistance != std::numeric_limits<int>::max() && space.distance(neighbor->index) + otherDistance < best) {
+            best = space.distance(neighbor->index) + otherDistance;
+            meeting = neighbor;
+        }
+    }
+}
+
+/*
+ * A* search: vertices are popped by distance + heuristic, so the search is
+ * pulled towards the target. A vertex whose distance improves after it was
+ * popped is queued again, which keeps the result exact for any admissible
+ * heuristic (consistent heuristics never trigger it).
+ */
+
+template<typename T>
+template<typename Heuristic>
+Path WeightedGraph<T>::getShortestDistanceAStar(const T &from, const T &to, Heuristic heuristic) {
+    auto source = findNode(from);
+    auto target = findNode(to);
+
+    auto &space = searchSpace;
+    auto &heap = space.heap;
+    space.reset(nodes.size());
+
+    space.relax(source->index, 0, nullptr);
+    heap.insert(source->index, heuristic(source->label, to));
+
+    while (!heap.isEmpty()) {
+        auto current = nodes[heap.remove()];
+        space.settle(current->index);
+        if (current == target)
+            break;
 
         for (auto &edge : current->getEdges()) {
-            if (!visited.count(edge->to)) {
-                auto distance = edge->weight + distances[current];
-                if (distance < distances.at(edge->to)) distances.at(edge->to) = distance;
-                previousNodes.at(edge->to) = current;
-                priorityQueue.push(NodeEntry{ distances[edge->to], edge->to });
+            auto distance = edge.weight + space.distance(current->index);
+            if (distance < space.distance(edge.to->index)) {
+                space.relax(edge.to->index, distance, current);
+                heap.update(edge.to->index, distance + heuristic(edge.to->label, to));
             }
         }
     }
 
-    Path path = buildPath(to, previousNodes);
+    Path path = buildPath(to, space);
 
     return path;
 }
 
+/*
+ * Every worker owns its SearchSpace and claims the next source row from a
+ * shared counter until all rows are done. Each search stops once all the
+ * (distinct) targets are settled.
+ */
+
+template<typename T>
+std::vector<int> WeightedGraph<T>::distanceTable(const std::vector<T> &sources, const std::vector<T> &targets,
+                                                 unsigned threads) {
+    std::vector<Node *> sourceNodes;
+    std::vector<Node *> targetNodes;
+    std::vector<char> isTarget(nodes.size(), false);
+    std::size_t targetCount{};
+
+    for (auto &label : sources)
+        sourceNodes.push_back(findNode(label));
+    for (auto &label : targets) {
+        targetNodes.push_back(findNode(label));
+        if (!isTarget[targetNodes.back()->index]) {
+            isTarget[targetNodes.back()->index] = true;
+            targetCount++;
+        }
+    }
+
+    /*
+     * No target: searchTargets would never stop early and run a full search
+     * per source for an empty row
+     */
+    if (sourceNodes.empty() || targetNodes.empty())
+        return {};
+
+    std::vector<int> table(sourceNodes.size() * targetNodes.size(), std::numeric_limits<int>::max());
+    std::atomic<std::size_t> nextRow{};
+
+    auto worker = [&]() {
+        SearchSpace space;
+        for (auto row = nextRow++; row < sourceNodes.size(); row = nextRow++) {
+            space.reset(nodes.size());
+            searchTargets(sourceNodes[row], isTarget, targetCount, space);
+            for (std::size_t column = 0; column < targetNodes.size(); column++)
+                table[row * targetNodes.size() + column] = space.distance(targetNodes[column]->index);
+        }
+    };
+
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(sourceNodes.size(), 1));
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; i++)
+        workers.emplace_back(worker);
+    worker();
+    for (auto &thread : workers)
+        thread.join();
+
+    return table;
+}
+
+template<typename T>
+void WeightedGraph<T>::searchTargets(Node *source, const std::vector<char> &isTarget, std::size_t targetCount,
+                                     SearchSpace &space) {
+    auto &heap = space.heap;
+    std::size_t settledTargets{};
+
+    space.relax(source->index, 0, nullptr);
+    heap.insert(source->index, 0);
+
+    while (!heap.isEmpty()) {
+        auto current = nodes[heap.remove()];
+        space.settle(current->index);
+        if (isTarget[current->index] && ++settledTargets == targetCount)
+            return;
+
+        for (auto &edge : current->getEdges()) {
+            if (!space.isSettled(edge.to->index)) {
+                auto distance = edge.weight + space.distance(current->index);
+                if (distance < space.distance(edge.to->index)) {
+                    space.relax(edge.to->index, distance, current);
+                    heap.update(edge.to->index, distance);
+                }
+            }
+        }
+    }
+}
+
 template<typename T>
-Path WeightedGraph<T>::buildPath(const T &to, const std::map<Node *, Node *> &previousNodes) {
+Path WeightedGraph<T>::buildPath(const T &to, const SearchSpace &space) {
     std::__1::stack<const std::string> stack;
-    pushPathsToStack(to, previousNodes, stack);
+    pushPathsToStack(to, space, stack);
 
     Path path;
     while (!stack.empty()) {
@@ -161,19 +568,80 @@ Path WeightedGraph<T>::buildPath(const T &to, const std::map<Node *, Node *> &pr
 
 template<typename T>
 std::stack<const std::string>
-WeightedGraph<T>::pushPathsToStack(const T &to, const std::map<Node *, Node *> &previousNodes,
+WeightedGraph<T>::pushPathsToStack(const T &to, const SearchSpace &space,
                                    std::stack<const std::string> &stack) {
     stack.push(to);
-    auto previous = to;
-    auto current = previousNodes.at(vertices->at(previous));
+    auto current = space.previous(vertices->at(to)->index);
     while (current != nullptr){
         stack.push(current->label);
-        previous = current->label;
-        current = previousNodes.at(vertices->at(previous));
+        current = space.previous(current->index);
     }
     return stack;
 }
 
+/*
+ * Path of a bidirectional search: source .. meeting from the forward search,
+ * then meeting .. target from the backward one.
+ */
+
+template<typename T>
+Path WeightedGraph<T>::buildPath(Node *meeting, const SearchSpace &forward, const SearchSpace &backward) {
+    std::vector<Node *> stack;
+    for (auto current = meeting; current != nullptr; current = forward.previous(current->index))
+        stack.push_back(current);
+
+    Path path;
+    while (!stack.empty()) {
+        path.addNode(stack.back()->label);
+        stack.pop_back();
+    }
+
+    for (auto current = backward.previous(meeting->index); current != nullptr; current = backward.previous(current->index))
+        path.addNode(current->label);
+
+    return path;
+}
+
+/*
+ * Vertex ids follow the (sorted) order of the vertices map, so the snapshot can
+ * look labels up with a binary search.
+ */
+
+template<typename T>
+CsrGraph<T> WeightedGraph<T>::freeze() const {
+    using Index = typename CsrGraph<T>::Index;
+
+    std::vector<T> labels;
+    std::vector<std::size_t> offsets;
+    std::vector<Index> neighbors;
+    std::vector<int> weights;
+    std::vector<Index> ids(nodes.size());
+
+    labels.reserve(vertices->size());
+    offsets.reserve(vertices->size() + 1);
+
+    for (auto &vertexPair : *vertices) {
+        ids[vertexPair.second->index] = static_cast<Index>(labels.size());
+        labels.push_back(vertexPair.first);
+    }
+
+    offsets.push_back(0);
+    for (auto &vertexPair : *vertices) {
+        for (auto &edge : vertexPair.second->getEdges()) {
+            neighbors.push_back(ids[edge.to->index]);
+            weights.push_back(edge.weight);
+        }
+        offsets.push_back(neighbors.size());
+    }
+
+    return CsrGraph<T>{std::move(labels), std::move(offsets), std::move(neighbors), std::move(weights), false};
+}
+
+
+template<typename T>
+ContractionHierarchy<T> WeightedGraph<T>::buildContractionHierarchy() const {
+    return ContractionHierarchy<T>{ freeze() };
+}
 
 
 template <typename T>
@@ -182,8 +650,8 @@ void WeightedGraph<T>::print() const {
     {
         std::cout << itr->first << " is connected to [ ";
         for (auto &values : itr->second->getEdges()) {
-            std::cout << values->from->label << "->";
-            std::cout << values->to->label << " ";
+            std::cout << values.from->label << "->";
+            std::cout << values.to->label << " ";
         }
         std::cout << "]\n";
     }
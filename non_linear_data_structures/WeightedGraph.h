@@ -51,6 +51,11 @@
 #include <set>
 #include <stack>
 #include <queue>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <thread>
+#include <atomic>
 
 
 #include "Edge.h"
@@ -58,6 +63,14 @@
 #include "Node.h"
 #include "Node.cpp"
 #include "Path.cpp"
+#include "CsrGraph.h"
+#include "CsrGraph.cpp"
+#include "IndexedHeap.h"
+#include "IndexedHeap.cpp"
+#include "ContractionHierarchy.h"
+#include "ContractionHierarchy.cpp"
+#include "UnionFind.h"
+#include "UnionFind.cpp"
 
 template<typename GRAPH>
 class NodeEntry{
@@ -70,6 +83,53 @@ public:
     int priority;
     Node *node;
 };
+/*
+ * Per-query state of a shortest path search, indexed by the dense Node::index.
+ * The arrays are kept between queries: instead of re-initialising V entries an
+ * epoch counter is bumped and any entry stamped with an older epoch reads as
+ * "not reached" / "not settled".
+ */
+template<typename GRAPH>
+class SearchSpace{
+public:
+    using Node = typename GRAPH::Node;
+    using NodeEntry = typename GRAPH::NodeEntry;
+public:
+    void reset(std::size_t size) {
+        distances.resize(size);
+        previousNodes.resize(size);
+        reached.resize(size, 0);
+        settled.resize(size, 0);
+        queue.clear();
+        heap.clear();
+        heap.resize(size);
+        if (++epoch == 0) {
+            std::fill(reached.begin(), reached.end(), 0);
+            std::fill(settled.begin(), settled.end(), 0);
+            epoch = 1;
+        }
+    }
+    [[nodiscard]] int distance(std::size_t index) const {
+        return reached[index] == epoch ? distances[index] : std::numeric_limits<int>::max();
+    }
+    Node *previous(std::size_t index) const { return reached[index] == epoch ? previousNodes[index] : nullptr; }
+    [[nodiscard]] bool isSettled(std::size_t index) const { return settled[index] == epoch; }
+    void settle(std::size_t index) { settled[index] = epoch; }
+    void relax(std::size_t index, int distance, Node *previous) {
+        distances[index] = distance;
+        previousNodes[index] = previous;
+        reached[index] = epoch;
+    }
+
+    std::vector<int> distances;
+    std::vector<Node *> previousNodes;
+    std::vector<unsigned> reached;
+    std::vector<unsigned> settled;
+    std::vector<NodeEntry> queue;
+    IndexedHeap<int> heap;
+    unsigned epoch{};
+};
+
 template<typename T>
 class WeightedGraph {
 
@@ -79,7 +139,16 @@ public:
     using Node = Node<WeightedGraph<T>>;
     using Edge = Edge<WeightedGraph<T>>;
     using NodeEntry = NodeEntry<WeightedGraph<T>>;
-    using iterator = typename std::map<T, Node*>::iterator;
+    using SearchSpace = SearchSpace<WeightedGraph<T>>;
+    using Arena = Arena<>;
+    using VertexMap = std::map<T, Node*, std::less<T>, ArenaAllocator<std::pair<const T, Node*>, Arena>>;
+    using iterator = typename VertexMap::iterator;
+
+    /*
+     * Lazy: binary heap of NodeEntry, stale duplicates are skipped when popped (O(E) entries)
+     * Indexed: indexed 4-ary heap with decreaseKey, at most one entry per vertex (O(V) entries)
+     */
+    enum class QueueMode { Lazy, Indexed };
 
 public:
 
@@ -92,26 +161,120 @@ public:
 
     void addEdge(const T& from, const T& to, const int& weight);
 
-    Path getShortestDistance(const T& from, const T& to);
+    Path getShortestDistance(const T& from, const T& to, QueueMode mode = QueueMode::Indexed);
+
+    /*
+     * Point to point searches, both stop once the target is settled:
+     *  - bidirectional: Dijkstra from both ends until the two searches meet
+     *  - A*: heuristic(label, to) must never overestimate the real distance
+     */
+    Path getShortestDistanceBidirectional(const T& from, const T& to);
+
+    template<typename Heuristic>
+    Path getShortestDistanceAStar(const T& from, const T& to, Heuristic heuristic);
 
-    Path buildPath(const T &to, const std::map<Node *, Node *> &previousNodes);
+    /*
+     * N x M distances in a flat row-major vector: table[i * M + j] is the distance
+     * from sources[i] to targets[j] (std::numeric_limits<int>::max() if unreachable).
+     * One search per source, the sources are shared between `threads` workers.
+     */
+    std::vector<int> distanceTable(const std::vector<T>& sources, const std::vector<T>& targets,
+                                   unsigned threads = std::thread::hardware_concurrency());
+
+    Path buildPath(const T &to, const SearchSpace &space);
     std::stack<const std::string> pushPathsToStack(const T &to,
-                                                   const std::map<Node *, Node *> &previousNodes,
+                                                   const SearchSpace &space,
                                                    std::stack<const std::string>& stack);
 
+    /*
+     * True when some edges form a cycle (a self loop or two edges between the
+     * same nodes count), checked with a union find in O(E a(V))
+     */
     bool hasCycle();
 
+    /*
+     * Index of the node in the flat arrays below, dense in [0, number of nodes)
+     */
+    std::size_t indexOf(const T &label);
+
+    /*
+     * components[indexOf(label)] is the connected component of every node,
+     * numbered in index order; returns the number of components
+     */
+    std::size_t connectedComponents(std::vector<std::size_t> &components);
+
+    /*
+     * Kruskal: the edges sorted by weight (parallel merge sort over `threads`)
+     * are taken one by one, skipping those whose ends are already connected.
+     * Every node and the edges of the minimum spanning tree (a forest if the
+     * graph is not connected) are added to `tree`; returns its total weight.
+     */
+    long long getMinimumSpanningTreeKruskal(WeightedGraph<T> &tree,
+                                            unsigned threads = std::thread::hardware_concurrency());
+
+    /*
+     * Prim (eager): the tree grows from one node, an indexed heap keeps for
+     * every node outside the tree its cheapest edge into it, O(E log V)
+     * without sorting the edges, the better choice on dense graphs. Same
+     * output as getMinimumSpanningTreeKruskal.
+     */
+    long long getMinimumSpanningTreePrim(WeightedGraph<T> &tree);
+
+    /*
+     * Packs the graph into a read-only CsrGraph (contiguous arrays)
+     */
+    CsrGraph<T> freeze() const;
+
+    /*
+     * Preprocesses the (static) graph into a contraction hierarchy answering
+     * getShortestDistance much faster than a plain search
+     */
+    ContractionHierarchy<T> buildContractionHierarchy() const;
+
     void print() const;
 
 private:
 
-    std::map<T, Node*> *vertices;
+    /*
+     * An edge of the graph by node indices, as sorted by Kruskal
+     */
+    struct SpanningEdge {
+        int weight;
+        std::size_t from;
+        std::size_t to;
+    };
+
+private:
+
+    /*
+     * Nodes, their edges and the tree nodes of `vertices` are all allocated in
+     * the arena: building the graph is a few block allocations and destroying
+     * it releases the blocks without visiting every node and edge.
+     */
+    Arena arena;
+    VertexMap *vertices;
+    std::vector<Node*> nodes;
+    SearchSpace searchSpace;
+    SearchSpace backwardSearchSpace;
 
 private:
 
     iterator getNode(const T& label);
 
-    bool hasCycle(Node *node, Node *parent, std::set<Node *> &visited);
+    Node *findNode(const T& label);
+
+    template<typename Item, typename Compare>
+    static void parallelSort(std::vector<Item> &items, unsigned threads, Compare compare);
+
+    void searchLazy(Node *source, Node *target, SearchSpace &space);
+
+    void searchIndexed(Node *source, Node *target, SearchSpace &space);
+
+    void searchTargets(Node *source, const std::vector<char> &isTarget, std::size_t targetCount, SearchSpace &space);
+
+    void relaxBidirectional(Node *current, SearchSpace &space, const SearchSpace &other, int &best, Node *&meeting);
+
+    Path buildPath(Node *meeting, const SearchSpace &forward, const SearchSpace &backward);
 };
 
 